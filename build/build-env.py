@@ -28,9 +28,9 @@ OldEnvironment = Environment;
 # this dictionary maps the name of a compiler program to a dictionary mapping the name of
 # a compiler switch of interest to the specific switch implementing the feature
 gCompilerOptions = {
-    'gcc' : {'optimization' : '-O2', 'debug' : '-g',  'exception_handling' : '',      'omp' : '-fopenmp'},
-    'g++' : {'optimization' : '-O2', 'debug' : '-g',  'exception_handling' : '',      'omp' : '-fopenmp'},
-    'cl'  : {'optimization' : '/Ox', 'debug' : ['/Zi', '-D_DEBUG', '/MTd'], 'exception_handling' : '/EHsc', 'omp' : '/openmp'}
+    'gcc' : {'optimization' : '-O2', 'debug' : '-g',  'exception_handling' : '',      'omp' : '-fopenmp', 'threads' : '-pthread'},
+    'g++' : {'optimization' : '-O2', 'debug' : '-g',  'exception_handling' : '',      'omp' : '-fopenmp', 'threads' : '-pthread'},
+    'cl'  : {'optimization' : '/Ox', 'debug' : ['/Zi', '-D_DEBUG', '/MTd'], 'exception_handling' : '/EHsc', 'omp' : '/openmp', 'threads' : ''}
   }
 
 
@@ -80,6 +80,10 @@ def getCXXFLAGS(mode, backend, CXX):
   if backend == 'omp':
     result.append(gCompilerOptions[CXX]['omp'])
 
+  # generate std::thread code
+  if backend == 'threads':
+    result.append(gCompilerOptions[CXX]['threads'])
+
   return result
 
 
@@ -117,7 +121,7 @@ def Environment():
 
   # add a variable to handle the device backend
   backend_variable = EnumVariable('backend', 'The parallel device backend to target', 'cuda',
-                                  allowed_values = ('cuda', 'omp', 'ocelot'))
+                                  allowed_values = ('cuda', 'omp', 'threads', 'ocelot'))
   vars.Add(backend_variable)
 
   # add a variable to handle RELEASE/DEBUG mode
@@ -140,7 +144,7 @@ def Environment():
   env.Tool('nvcc', toolpath = [os.path.join(thisDir)])
 
   # get the preprocessor define to use for the backend
-  backend_define = { 'cuda' : 'THRUST_DEVICE_BACKEND_CUDA', 'omp' : 'THRUST_DEVICE_BACKEND_OMP', 'ocelot' : 'THRUST_DEVICE_BACKEND_CUDA' }[env['backend']] 
+  backend_define = { 'cuda' : 'THRUST_DEVICE_BACKEND_CUDA', 'omp' : 'THRUST_DEVICE_BACKEND_OMP', 'threads' : 'THRUST_DEVICE_BACKEND_THREADS', 'ocelot' : 'THRUST_DEVICE_BACKEND_CUDA' }[env['backend']] 
   env.Append(CFLAGS = ['-DTHRUST_DEVICE_BACKEND=%s' % backend_define])
 
   # scons has problems with finding the proper LIBPATH with Visual Studio Express 2008
@@ -200,6 +204,11 @@ def Environment():
     else:
       raise ValueError, "Unknown OS.  What is the name of the OpenMP library?"
 
+  # link against pthreads if necessary
+  if env['backend'] == 'threads':
+    if os.name == 'posix':
+      env.Append(LIBS = ['pthread'])
+
   # set thrust include path
   env.Append(CPPPATH = os.path.dirname(thisDir))
 
@@ -0,0 +1,252 @@
+#include <unittest/unittest.h>
+#include <thrust/sort.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/functional.h>
+#include <thrust/count.h>
+#include <thrust/sequence.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/execution_config.h>
+
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+
+#include <thrust/async.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+#include <omp.h>
+#endif
+
+template <typename T>
+void TestAsyncReduce(const size_t n)
+{
+    thrust::host_vector<T>   h_data = unittest::random_integers<T>(n);
+    thrust::device_vector<T> d_data = h_data;
+
+    thrust::future<T> sum  = thrust::async::reduce(d_data.begin(), d_data.end());
+    thrust::future<T> init = thrust::async::reduce(d_data.begin(), d_data.end(), T(13));
+    thrust::future<T> max  = thrust::async::reduce(d_data.begin(), d_data.end(), T(0), thrust::maximum<T>());
+
+    ASSERT_ALMOST_EQUAL(thrust::reduce(h_data.begin(), h_data.end()), sum.get());
+    ASSERT_ALMOST_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), T(13)), init.get());
+    ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), T(0), thrust::maximum<T>()), max.get());
+
+    // a future may be queried repeatedly
+    ASSERT_EQUAL(sum.ready(), true);
+    ASSERT_ALMOST_EQUAL(thrust::reduce(h_data.begin(), h_data.end()), sum.get());
+}
+DECLARE_VARIABLE_UNITTEST(TestAsyncReduce);
+
+
+template <typename T>
+void TestAsyncPipeline(const size_t n)
+{
+    thrust::host_vector<T> h_keys = unittest::random_integers<T>(n);
+
+    // random_integers repeats its sequence, so the values and the other
+    // input are made to differ from the keys
+    thrust::host_vector<T> h_values(n);
+    thrust::sequence(h_values.begin(), h_values.end());
+
+    thrust::host_vector<T> h_other(n);
+    thrust::transform(h_keys.begin(), h_keys.end(), h_other.begin(), thrust::negate<T>());
+
+    thrust::device_vector<T> d_keys   = h_keys;
+    thrust::device_vector<T> d_values = h_values;
+    thrust::device_vector<T> d_other  = h_other;
+    thrust::device_vector<T> d_result(n);
+
+    // two independent chains: sort_by_key -> copy -> scan, and sort -> reduce
+    thrust::event sorted = thrust::async::sort_by_key(d_keys.begin(), d_keys.end(), d_values.begin());
+    thrust::future<typename thrust::device_vector<T>::iterator> copied =
+      thrust::async::copy(sorted, d_values.begin(), d_values.end(), d_result.begin());
+    thrust::future<typename thrust::device_vector<T>::iterator> scanned =
+      thrust::async::inclusive_scan(copied, d_result.begin(), d_result.end(), d_result.begin());
+
+    thrust::event other_sorted = thrust::async::sort(d_other.begin(), d_other.end(), thrust::greater<T>());
+    thrust::future<T> other_sum = thrust::async::reduce(other_sorted, d_other.begin(), d_other.end());
+
+    thrust::sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin());
+    thrust::host_vector<T> h_result(n);
+    thrust::inclusive_scan(h_values.begin(), h_values.end(), h_result.begin());
+
+    thrust::sort(h_other.begin(), h_other.end(), thrust::greater<T>());
+
+    ASSERT_EQUAL(scanned.get() - d_result.begin(), n);
+    ASSERT_EQUAL(d_keys, h_keys);
+    ASSERT_ALMOST_EQUAL(d_result, h_result);
+
+    ASSERT_ALMOST_EQUAL(other_sum.get(), thrust::reduce(h_other.begin(), h_other.end()));
+    other_sorted.wait();
+    ASSERT_EQUAL(d_other, h_other);
+}
+DECLARE_VARIABLE_UNITTEST(TestAsyncPipeline);
+
+
+void TestAsyncDefaultEvent(void)
+{
+    // a default-constructed event is already complete
+    ASSERT_EQUAL(thrust::event().ready(), true);
+    thrust::event().wait();
+
+    thrust::device_vector<int> v(10, 1);
+
+    thrust::future<int> sum = thrust::async::reduce(thrust::event(), v.begin(), v.end());
+    ASSERT_EQUAL(sum.get(), 10);
+}
+DECLARE_UNITTEST(TestAsyncDefaultEvent);
+
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+
+struct async_record_team_size
+{
+    __host__ __device__
+    void operator()(int& x) const { x = omp_get_num_threads(); }
+};
+
+void async_wait_for(thrust::event e)
+{
+    e.wait();
+}
+
+void TestAsyncExecutionConfig(void)
+{
+    thrust::device_vector<int> team_sizes(1000, 0);
+
+    thrust::omp::execution_config config;
+    config.num_threads = 3;
+
+    thrust::omp::scoped_execution_config scope(config);
+
+    // the operation runs under the configuration of the launching thread,
+    // even when another thread, which has no configuration, runs it
+    thrust::event done = thrust::async::for_each(team_sizes.begin(), team_sizes.end(), async_record_team_size());
+
+    std::thread waiter(async_wait_for, done);
+    waiter.join();
+
+    ASSERT_EQUAL(thrust::count(team_sizes.begin(), team_sizes.end(), 3), 1000);
+
+    config.num_threads = 1;
+
+    thrust::omp::scoped_execution_config inner_scope(config);
+
+    thrust::async::for_each(team_sizes.begin(), team_sizes.end(), async_record_team_size()).wait();
+
+    ASSERT_EQUAL(thrust::count(team_sizes.begin(), team_sizes.end(), 1), 1000);
+}
+DECLARE_UNITTEST(TestAsyncExecutionConfig);
+
+struct async_team_size
+{
+    __host__ __device__
+    int operator()(int) const { return omp_get_num_threads(); }
+};
+
+std::atomic<bool> async_gate_open(false);
+
+struct async_wait_for_gate
+{
+    __host__ __device__
+    void operator()(int) const
+    {
+        while(!async_gate_open.load())
+            std::this_thread::yield();
+    }
+};
+
+void TestAsyncDividesThreads(void)
+{
+    const int num_operations = 4;
+
+    thrust::device_vector<int> data(10000, 0);
+    thrust::device_vector<int> gate(1, 0);
+
+    thrust::omp::execution_config config;
+    config.num_threads = 8;
+
+    thrust::omp::scoped_execution_config scope(config);
+
+    // an operation running alone uses every thread of the configuration
+    thrust::future<int> alone =
+      thrust::async::transform_reduce(data.begin(), data.end(), async_team_size(), 0, thrust::maximum<int>());
+
+    ASSERT_EQUAL(alone.get(), 8);
+
+    // operations released at once by a common dependency share the threads
+    async_gate_open = false;
+
+    thrust::event opened = thrust::async::for_each(gate.begin(), gate.end(), async_wait_for_gate());
+
+    std::vector< thrust::future<int> > team_sizes;
+
+    for(int i = 0; i < num_operations; i++)
+        team_sizes.push_back(thrust::async::transform_reduce(opened, data.begin(), data.end(), async_team_size(), 0, thrust::maximum<int>()));
+
+    async_gate_open = true;
+
+    for(int i = 0; i < num_operations; i++)
+        ASSERT_EQUAL(team_sizes[i].get(), 8 / num_operations);
+}
+DECLARE_UNITTEST(TestAsyncDividesThreads);
+
+#endif // THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+
+
+// exceptions may not escape an OpenMP parallel region, so only the threads
+// backend can propagate an exception thrown by a function object
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+
+struct async_throw_on_call
+{
+    __host__ __device__
+    void operator()(int) const { throw std::runtime_error("async_throw_on_call"); }
+};
+
+void TestAsyncException(void)
+{
+    thrust::device_vector<int> v(10, 1);
+
+    thrust::event failed = thrust::async::for_each(v.begin(), v.end(), async_throw_on_call());
+
+    // a dependent operation completes with the same exception, without executing
+    thrust::future<typename thrust::device_vector<int>::iterator> scanned =
+      thrust::async::exclusive_scan(failed, v.begin(), v.end(), v.begin());
+
+    bool caught = false;
+    try
+    {
+        failed.wait();
+    }
+    catch(std::runtime_error &)
+    {
+        caught = true;
+    }
+    ASSERT_EQUAL(caught, true);
+
+    caught = false;
+    try
+    {
+        scanned.get();
+    }
+    catch(std::runtime_error &)
+    {
+        caught = true;
+    }
+    ASSERT_EQUAL(caught, true);
+
+    thrust::host_vector<int> ones(10, 1);
+    ASSERT_EQUAL(v, ones);
+}
+DECLARE_UNITTEST(TestAsyncException);
+
+#endif // THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+
+#endif // THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+
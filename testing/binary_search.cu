@@ -3,6 +3,8 @@
 
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/workspace.h>
 
 //////////////////////
 // Scalar Functions //
@@ -126,6 +128,28 @@ void TestScalarEqualRangeSimple(void)
 }
 DECLARE_VECTOR_UNITTEST(TestScalarEqualRangeSimple);
 
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA && __THRUST_HAS_TEMPORARY_CACHE
+void TestScalarSearchDoesNotAllocate(void)
+{
+    thrust::device_vector<int> vec(5);
+
+    vec[0] = 0;
+    vec[1] = 2;
+    vec[2] = 5;
+    vec[3] = 7;
+    vec[4] = 8;
+
+    // an empty workspace makes every temporary allocation throw
+    thrust::scoped_workspace workspace(thrust::device_ptr<void>(), 0);
+
+    ASSERT_EQUAL(thrust::lower_bound(vec.begin(), vec.end(), 5) - vec.begin(), 2);
+    ASSERT_EQUAL(thrust::upper_bound(vec.begin(), vec.end(), 5) - vec.begin(), 3);
+    ASSERT_EQUAL(thrust::binary_search(vec.begin(), vec.end(), 7), true);
+    ASSERT_EQUAL(thrust::binary_search(vec.begin(), vec.end(), 6), false);
+}
+DECLARE_UNITTEST(TestScalarSearchDoesNotAllocate);
+#endif // THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+
 
 //////////////////////
 // Vector Functions //
@@ -400,3 +424,145 @@ struct TestVectorBinarySearch
 };
 VariableUnitTest<TestVectorBinarySearch, NumericTypes> TestVectorBinarySearchInstance;
 
+
+
+template <typename T>
+struct TestVectorSearchSortedValues
+{
+  void operator()(const size_t n)
+  {
+// XXX an MSVC bug causes problems inside std::stable_sort's implementation:
+//     std::lower_bound/upper_bound is confused with thrust::lower_bound/upper_bound
+#if (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC) && (THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP)
+    KNOWN_FAILURE;
+#else
+    thrust::host_vector<T>   h_vec = unittest::random_integers<T>(n);
+    thrust::device_vector<T> d_vec = h_vec;
+
+    thrust::sort(h_vec.begin(), h_vec.end());
+    thrust::sort(d_vec.begin(), d_vec.end());
+
+    // many sorted values are found by merging them with the range
+    thrust::host_vector<T>   h_input = unittest::random_integers<T>(4*n);
+    thrust::sort(h_input.begin(), h_input.end());
+    thrust::device_vector<T> d_input = h_input;
+    
+    thrust::host_vector<int>   h_output(4*n);
+    thrust::device_vector<int> d_output(4*n);
+
+    thrust::lower_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+    thrust::lower_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::upper_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+    thrust::upper_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::binary_search(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+    thrust::binary_search(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+
+    ASSERT_EQUAL(h_output, d_output);
+
+    // values which are almost sorted must still be found correctly
+    if (n > 0)
+    {
+      h_input[0] = h_input[4*n - 1];
+      d_input = h_input;
+
+      thrust::lower_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+      thrust::lower_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+
+      ASSERT_EQUAL(h_output, d_output);
+
+      thrust::upper_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+      thrust::upper_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+
+      ASSERT_EQUAL(h_output, d_output);
+    }
+#endif
+  }
+};
+VariableUnitTest<TestVectorSearchSortedValues, NumericTypes> TestVectorSearchSortedValuesInstance;
+
+
+void TestVectorSearchValuesInPlace(void)
+{
+    const int n = 1 << 16;
+
+    thrust::host_vector<int> h_vec = unittest::random_integers<int>(n);
+    thrust::sort(h_vec.begin(), h_vec.end());
+    thrust::device_vector<int> d_vec = h_vec;
+
+    thrust::host_vector<int> h_input = unittest::random_integers<int>(4 * n);
+    thrust::sort(h_input.begin(), h_input.end());
+
+    // all but one of the values are in order, so the merge finds most of
+    // them before the search falls back to searching for each value
+    std::swap(h_input[0], h_input[4 * n - 1]);
+
+    thrust::host_vector<int> h_result = h_input;
+    thrust::device_vector<int> d_result = h_input;
+
+    // the results overwrite the values
+    thrust::lower_bound(h_vec.begin(), h_vec.end(), h_result.begin(), h_result.end(), h_result.begin());
+    thrust::lower_bound(d_vec.begin(), d_vec.end(), d_result.begin(), d_result.end(), d_result.begin());
+
+    ASSERT_EQUAL(h_result, d_result);
+
+    h_result = h_input;
+    d_result = h_input;
+
+    thrust::upper_bound(h_vec.begin(), h_vec.end(), h_result.begin(), h_result.end(), h_result.begin());
+    thrust::upper_bound(d_vec.begin(), d_vec.end(), d_result.begin(), d_result.end(), d_result.begin());
+
+    ASSERT_EQUAL(h_result, d_result);
+
+    h_result = h_input;
+    d_result = h_input;
+
+    thrust::binary_search(h_vec.begin(), h_vec.end(), h_result.begin(), h_result.end(), h_result.begin());
+    thrust::binary_search(d_vec.begin(), d_vec.end(), d_result.begin(), d_result.end(), d_result.begin());
+
+    ASSERT_EQUAL(h_result, d_result);
+}
+DECLARE_UNITTEST(TestVectorSearchValuesInPlace);
+
+
+void TestVectorSearchCountingValues(void)
+{
+    const int n = 1 << 12;
+
+    thrust::host_vector<int> h_vec = unittest::random_integers<int>(n);
+
+    for(int i = 0; i < n; i++)
+        h_vec[i] = (unsigned int) h_vec[i] % (4 * n);
+
+    thrust::sort(h_vec.begin(), h_vec.end());
+    thrust::device_vector<int> d_vec = h_vec;
+
+    // the values are produced by an iterator rather than stored
+    thrust::counting_iterator<int, thrust::host_space_tag>   h_first(0);
+    thrust::counting_iterator<int, thrust::device_space_tag> d_first(0);
+
+    thrust::host_vector<int>   h_output(4 * n);
+    thrust::device_vector<int> d_output(4 * n);
+
+    thrust::lower_bound(h_vec.begin(), h_vec.end(), h_first, h_first + 4 * n, h_output.begin());
+    thrust::lower_bound(d_vec.begin(), d_vec.end(), d_first, d_first + 4 * n, d_output.begin());
+
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::upper_bound(h_vec.begin(), h_vec.end(), h_first, h_first + 4 * n, h_output.begin());
+    thrust::upper_bound(d_vec.begin(), d_vec.end(), d_first, d_first + 4 * n, d_output.begin());
+
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::binary_search(h_vec.begin(), h_vec.end(), h_first, h_first + 4 * n, h_output.begin());
+    thrust::binary_search(d_vec.begin(), d_vec.end(), d_first, d_first + 4 * n, d_output.begin());
+
+    ASSERT_EQUAL(h_output, d_output);
+}
+DECLARE_UNITTEST(TestVectorSearchCountingValues);
+
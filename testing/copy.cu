@@ -4,6 +4,8 @@
 #include <list>
 #include <iterator>
 #include <thrust/iterator/counting_iterator.h>
+#include <thrust/sequence.h>
+#include <thrust/equal.h>
 
 void TestCopyFromConstIterator(void)
 {
@@ -334,3 +336,50 @@ void TestCopyCountingIterator(void)
 DECLARE_VECTOR_UNITTEST(TestCopyCountingIterator);
 
 
+
+template <typename T>
+void TestCopyTrivialRanges(const size_t n)
+{
+    thrust::host_vector<T>   h_data = unittest::random_samples<T>(n);
+    thrust::device_vector<T> d_data = h_data;
+
+    thrust::host_vector<T>   h_result(n);
+    thrust::device_vector<T> d_result(n);
+
+    // device to device
+    thrust::copy(d_data.begin(), d_data.end(), d_result.begin());
+    ASSERT_EQUAL(d_result, h_data);
+
+    // device to host
+    thrust::copy(d_data.begin(), d_data.end(), h_result.begin());
+    ASSERT_EQUAL(h_result, h_data);
+
+    // host to device, at an offset
+    if (n > 1)
+    {
+        thrust::copy(h_data.begin() + 1, h_data.end(), d_result.begin());
+        ASSERT_EQUAL(d_result[n - 2], h_data[n - 1]);
+        ASSERT_EQUAL(d_result[n - 1], h_data[n - 1]);
+    }
+}
+DECLARE_VARIABLE_UNITTEST(TestCopyTrivialRanges);
+
+void TestCopyLargeTrivialRange(void)
+{
+    // large enough to use non-temporal stores
+    const size_t n = (size_t(48) << 20) / sizeof(int);
+
+    thrust::device_vector<int> d_data(n);
+    thrust::sequence(d_data.begin(), d_data.end());
+
+    thrust::device_vector<int> d_result(n, -1);
+
+    // a destination which is not 16-byte aligned
+    thrust::copy(d_data.begin(), d_data.end() - 3, d_result.begin() + 3);
+
+    ASSERT_EQUAL(d_result[0], -1);
+    ASSERT_EQUAL(d_result[3], 0);
+    ASSERT_EQUAL(d_result[n - 1], int(n - 4));
+    ASSERT_EQUAL(thrust::equal(d_data.begin(), d_data.end() - 3, d_result.begin() + 3), true);
+}
+DECLARE_UNITTEST(TestCopyLargeTrivialRange);
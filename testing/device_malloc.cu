@@ -0,0 +1,61 @@
+#include <unittest/unittest.h>
+#include <thrust/device_malloc.h>
+#include <thrust/device_free.h>
+#include <thrust/device_vector.h>
+
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+
+template <typename T>
+bool is_aligned(T *ptr, std::size_t alignment)
+{
+    return reinterpret_cast<std::size_t>(ptr) % alignment == 0;
+}
+
+void TestDeviceMallocAlignment(void)
+{
+    const std::size_t alignment = thrust::detail::device::generic::malloc_alignment;
+
+    const std::size_t sizes[] = {0, 1, 3, 64, 1000, 1 << 20};
+
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(std::size_t); i++)
+    {
+        thrust::device_ptr<char> ptr = thrust::device_malloc<char>(sizes[i]);
+
+        ASSERT_EQUAL(is_aligned(thrust::raw_pointer_cast(ptr), alignment), true);
+
+        thrust::device_free(ptr);
+    }
+
+    thrust::device_vector<char> vec(13);
+    ASSERT_EQUAL(is_aligned(thrust::raw_pointer_cast(&vec[0]), alignment), true);
+}
+DECLARE_UNITTEST(TestDeviceMallocAlignment);
+
+void TestDeviceMallocHugePages(void)
+{
+    const std::size_t threshold = thrust::detail::device::generic::huge_page_threshold<0>();
+
+    // huge pages are disabled
+    if (threshold == 0)
+        return;
+
+    // a size which is not a whole number of huge pages
+    const std::size_t n = threshold + 1;
+
+    thrust::device_ptr<char> ptr = thrust::device_malloc<char>(n);
+
+    ASSERT_EQUAL(is_aligned(thrust::raw_pointer_cast(ptr), thrust::detail::device::generic::huge_page_size), true);
+
+    // the whole block is usable
+    ptr[0]     = 13;
+    ptr[n - 1] = 42;
+
+    ASSERT_EQUAL(ptr[0],     13);
+    ASSERT_EQUAL(ptr[n - 1], 42);
+
+    thrust::device_free(ptr);
+}
+DECLARE_UNITTEST(TestDeviceMallocHugePages);
+
+#endif // THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+
@@ -54,4 +54,48 @@ void TestFindIfSimple(void)
 }
 DECLARE_VECTOR_UNITTEST(TestFindIfSimple);
 
+template <typename T>
+void TestFind(const size_t n)
+{
+    thrust::host_vector<T>   h_data = unittest::random_integers<T>(n);
+    thrust::device_vector<T> d_data = h_data;
+
+    typename thrust::host_vector<T>::iterator   h_iter;
+    typename thrust::device_vector<T>::iterator d_iter;
+
+    h_iter = thrust::find(h_data.begin(), h_data.end(), T(0));
+    d_iter = thrust::find(d_data.begin(), d_data.end(), T(0));
+    ASSERT_EQUAL(h_iter - h_data.begin(), d_iter - d_data.begin());
+
+    for (size_t i = 1; i < n; i *= 2)
+    {
+        T sample = h_data[i];
+        h_iter = thrust::find(h_data.begin(), h_data.end(), sample);
+        d_iter = thrust::find(d_data.begin(), d_data.end(), sample);
+        ASSERT_EQUAL(h_iter - h_data.begin(), d_iter - d_data.begin());
+    }
+}
+DECLARE_VARIABLE_UNITTEST(TestFind);
+
+template <typename T>
+void TestFindIfLateMatches(const size_t n)
+{
+    // a match near the end of each of several blocks must not
+    // hide an earlier match found later by another thread
+    thrust::host_vector<T> h_data(n, T(0));
+
+    for (size_t i = n / 2; i < n; i += 1000)
+        h_data[i] = T(1);
+
+    thrust::device_vector<T> d_data = h_data;
+
+    for (size_t i = 0; i < n; i += n / 7 + 1)
+    {
+        size_t h_index = thrust::find_if(h_data.begin() + i, h_data.end(), equal_to_value_pred<T>(1)) - h_data.begin();
+        size_t d_index = thrust::find_if(d_data.begin() + i, d_data.end(), equal_to_value_pred<T>(1)) - d_data.begin();
+
+        ASSERT_EQUAL(h_index, d_index);
+    }
+}
+DECLARE_VARIABLE_UNITTEST(TestFindIfLateMatches);
 
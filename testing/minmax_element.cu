@@ -1,5 +1,6 @@
 #include <unittest/unittest.h>
 #include <thrust/extrema.h>
+#include <thrust/functional.h>
 
 template <class Vector>
 void TestMinMaxElementSimple(void)
@@ -50,3 +51,80 @@ void TestMinMaxElement(const size_t n)
 }
 DECLARE_VARIABLE_UNITTEST(TestMinMaxElement);
 
+// checks min_element, max_element and minmax_element of data against the
+// host, under comp and under the reverse order
+template<typename T, typename BinaryPredicate>
+void CheckExtremaPositions(const thrust::host_vector<T>& h_data, BinaryPredicate comp)
+{
+    thrust::device_vector<T> d_data = h_data;
+
+    size_t h_min = thrust::min_element(h_data.begin(), h_data.end(), comp) - h_data.begin();
+    size_t h_max = thrust::max_element(h_data.begin(), h_data.end(), comp) - h_data.begin();
+
+    ASSERT_EQUAL(h_min, size_t(thrust::min_element(d_data.begin(), d_data.end(), comp) - d_data.begin()));
+    ASSERT_EQUAL(h_max, size_t(thrust::max_element(d_data.begin(), d_data.end(), comp) - d_data.begin()));
+
+    // both extrema are the first occurrences
+    thrust::pair<typename thrust::device_vector<T>::iterator,
+                 typename thrust::device_vector<T>::iterator> d_result = thrust::minmax_element(d_data.begin(), d_data.end(), comp);
+
+    ASSERT_EQUAL(h_min, size_t(d_result.first  - d_data.begin()));
+    ASSERT_EQUAL(h_max, size_t(d_result.second - d_data.begin()));
+}
+
+template<typename T>
+void TestExtremaDuplicates(const size_t n)
+{
+    // few distinct values, and the extrema occur only in the second half
+    thrust::host_vector<unsigned int> h_random = unittest::random_integers<unsigned int>(n);
+    thrust::host_vector<T> h_data(n);
+    for (size_t i = 0; i < n; i++)
+        h_data[i] = (i < n / 2) ? T(h_random[i] % 3 + 1) : T(h_random[i] % 5);
+
+    CheckExtremaPositions(h_data, thrust::less<T>());
+    CheckExtremaPositions(h_data, thrust::greater<T>());
+}
+DECLARE_VARIABLE_UNITTEST(TestExtremaDuplicates);
+
+// orders integers by their tens, so that e.g. 3 and 7 are equivalent
+struct less_tens
+{
+    __host__ __device__
+    bool operator()(int a, int b) const { return a / 10 < b / 10; }
+};
+
+void TestExtremaFirstInLaterBlock(void)
+{
+    // several blocks of the OpenMP extrema, which hold 16K elements each
+    const size_t block = 1 << 14;
+    const size_t n     = 5 * block + 123;
+
+    thrust::host_vector<unsigned int> h_random = unittest::random_integers<unsigned int>(n);
+
+    // the middle of the order everywhere, with values from the next
+    // smaller and next larger tens in the first blocks
+    thrust::host_vector<int> h_data(n);
+    for (size_t i = 0; i < n; i++)
+        h_data[i] = 50 + int(h_random[i] % 30);
+    for (size_t i = 100; i < 2 * block; i += 1000)
+        h_data[i] = 40 + int(h_random[i] % 10);
+    for (size_t i = 200; i < 2 * block; i += 1000)
+        h_data[i] = 80 + int(h_random[i] % 10);
+
+    // the extrema first appear in later blocks, followed by smaller and
+    // larger but equivalent values in the blocks after them
+    h_data[2 * block + 777] = 37;
+    h_data[3 * block + 5]   = 30;
+    h_data[4 * block + 9]   = 31;
+
+    h_data[3 * block + 901] = 91;
+    h_data[4 * block + 17]  = 99;
+    h_data[n - 1]           = 90;
+
+    CheckExtremaPositions(h_data, less_tens());
+
+    ASSERT_EQUAL(h_data[thrust::min_element(h_data.begin(), h_data.end(), less_tens()) - h_data.begin()], 37);
+    ASSERT_EQUAL(h_data[thrust::max_element(h_data.begin(), h_data.end(), less_tens()) - h_data.begin()], 91);
+}
+DECLARE_UNITTEST(TestExtremaFirstInLaterBlock);
+
@@ -0,0 +1,164 @@
+#include <unittest/unittest.h>
+#include <thrust/reduce.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/inner_product.h>
+#include <thrust/scan.h>
+#include <thrust/functional.h>
+
+#include <thrust/execution_config.h>
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+
+#include <omp.h>
+
+using namespace unittest;
+
+// floating point addition is not associative, so the results below
+// only agree across thread counts when the blocking is fixed by n
+
+template <typename T>
+struct square
+{
+    __host__ __device__
+    T operator()(T x) const { return x * x; }
+};
+
+template <typename T>
+thrust::host_vector<T> mixed_magnitude_samples(size_t n)
+{
+    thrust::host_vector<T> h_data = unittest::random_samples<T>(n);
+
+    for(size_t i = 0; i < n; i++)
+        h_data[i] = (i % 3 == 0) ? T(1e7) * h_data[i] : T(1e-3) * h_data[i];
+
+    return h_data;
+}
+
+template <typename T>
+void _TestDeterministicReduce(const size_t n)
+{
+    thrust::device_vector<T> d_data = mixed_magnitude_samples<T>(n);
+    thrust::device_vector<T> d_other = mixed_magnitude_samples<T>(n);
+
+    thrust::omp::scoped_deterministic_reductions deterministic;
+
+    int max_threads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+
+    T reference_sum   = thrust::reduce(d_data.begin(), d_data.end(), T(0));
+    T reference_norm  = thrust::transform_reduce(d_data.begin(), d_data.end(), square<T>(), T(0), thrust::plus<T>());
+    T reference_inner = thrust::inner_product(d_data.begin(), d_data.end(), d_other.begin(), T(0));
+
+    for(int num_threads = 2; num_threads <= 8; num_threads++)
+    {
+        omp_set_num_threads(num_threads);
+
+        ASSERT_EQUAL(thrust::reduce(d_data.begin(), d_data.end(), T(0)), reference_sum);
+        ASSERT_EQUAL(thrust::transform_reduce(d_data.begin(), d_data.end(), square<T>(), T(0), thrust::plus<T>()), reference_norm);
+        ASSERT_EQUAL(thrust::inner_product(d_data.begin(), d_data.end(), d_other.begin(), T(0)), reference_inner);
+    }
+
+    omp_set_num_threads(max_threads);
+}
+void TestDeterministicReduce(void)
+{
+    size_t sizes[] = {1, 2, 1000, 4095, 4096, 4097, 12345, (1 << 18) + 3};
+
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); i++)
+    {
+        _TestDeterministicReduce<float>(sizes[i]);
+        _TestDeterministicReduce<double>(sizes[i]);
+    }
+}
+DECLARE_UNITTEST(TestDeterministicReduce);
+
+template <typename T>
+void _TestDeterministicScan(const size_t n)
+{
+    thrust::device_vector<T> d_input = mixed_magnitude_samples<T>(n);
+    thrust::device_vector<T> d_output(n);
+
+    thrust::omp::scoped_deterministic_reductions deterministic;
+
+    int max_threads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+
+    thrust::inclusive_scan(d_input.begin(), d_input.end(), d_output.begin());
+    thrust::host_vector<T> reference_inclusive = d_output;
+
+    thrust::exclusive_scan(d_input.begin(), d_input.end(), d_output.begin(), T(13));
+    thrust::host_vector<T> reference_exclusive = d_output;
+
+    for(int num_threads = 2; num_threads <= 8; num_threads++)
+    {
+        omp_set_num_threads(num_threads);
+
+        thrust::inclusive_scan(d_input.begin(), d_input.end(), d_output.begin());
+        ASSERT_EQUAL(d_output, reference_inclusive);
+
+        thrust::exclusive_scan(d_input.begin(), d_input.end(), d_output.begin(), T(13));
+        ASSERT_EQUAL(d_output, reference_exclusive);
+    }
+
+    omp_set_num_threads(max_threads);
+}
+void TestDeterministicScan(void)
+{
+    size_t sizes[] = {1, 2, 1000, 4095, 4096, 4097, 12345, (1 << 18) + 3};
+
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); i++)
+    {
+        _TestDeterministicScan<float>(sizes[i]);
+        _TestDeterministicScan<double>(sizes[i]);
+    }
+}
+DECLARE_UNITTEST(TestDeterministicScan);
+
+void TestDeterministicReductionsScope(void)
+{
+    using namespace thrust::omp;
+
+    ASSERT_EQUAL(deterministic_reductions(), false);
+
+    {
+        scoped_deterministic_reductions deterministic;
+
+        ASSERT_EQUAL(deterministic_reductions(), true);
+
+        {
+            scoped_deterministic_reductions nondeterministic(false);
+
+            ASSERT_EQUAL(deterministic_reductions(), false);
+        }
+
+        ASSERT_EQUAL(deterministic_reductions(), true);
+    }
+
+    ASSERT_EQUAL(deterministic_reductions(), false);
+}
+DECLARE_UNITTEST(TestDeterministicReductionsScope);
+
+void TestDeterministicReductionsPerThread(void)
+{
+    using namespace thrust::omp;
+
+    scoped_deterministic_reductions deterministic;
+
+    // the scope of this thread does not affect the others
+    int other_mode = 0;
+
+#   pragma omp parallel num_threads(2)
+    {
+        if (omp_get_thread_num() == 1)
+            other_mode = deterministic_reductions();
+    }
+
+    ASSERT_EQUAL(other_mode, 0);
+    ASSERT_EQUAL(deterministic_reductions(), true);
+}
+DECLARE_UNITTEST(TestDeterministicReductionsPerThread);
+
+#endif // THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+
@@ -0,0 +1,173 @@
+#include <unittest/unittest.h>
+#include <thrust/for_each.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
+#include <thrust/copy.h>
+#include <thrust/sequence.h>
+#include <thrust/functional.h>
+
+#include <thrust/execution_config.h>
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+
+#include <omp.h>
+
+using namespace unittest;
+
+struct record_team_size
+{
+    __host__ __device__
+    void operator()(int& x) const { x = omp_get_num_threads(); }
+};
+
+template <typename T>
+struct is_even
+{
+    __host__ __device__
+    bool operator()(T x) const { return (x % 2) == 0; }
+};
+
+void TestExecutionConfigScope(void)
+{
+    using namespace thrust::omp;
+
+    ASSERT_EQUAL(current_execution_config().num_threads, 0);
+    ASSERT_EQUAL(current_execution_config().serial_cutoff, 0u);
+    ASSERT_EQUAL(current_execution_config().schedule == static_schedule, true);
+
+    execution_config outer;
+    outer.num_threads = 3;
+
+    {
+        scoped_execution_config outer_scope(outer);
+
+        ASSERT_EQUAL(current_execution_config().num_threads, 3);
+
+        execution_config inner;
+        inner.schedule      = dynamic_schedule;
+        inner.serial_cutoff = 100;
+
+        {
+            scoped_execution_config inner_scope(inner);
+
+            ASSERT_EQUAL(current_execution_config().num_threads, 0);
+            ASSERT_EQUAL(current_execution_config().serial_cutoff, 100u);
+            ASSERT_EQUAL(current_execution_config().schedule == dynamic_schedule, true);
+        }
+
+        ASSERT_EQUAL(current_execution_config().num_threads, 3);
+    }
+
+    ASSERT_EQUAL(current_execution_config().num_threads, 0);
+}
+DECLARE_UNITTEST(TestExecutionConfigScope);
+
+void TestExecutionConfigNumThreads(void)
+{
+    using namespace thrust::omp;
+
+    int max_threads = omp_get_max_threads();
+
+    thrust::device_vector<int> team_sizes(10000, 0);
+
+    execution_config config;
+    config.num_threads = 2;
+
+    {
+        scoped_execution_config scope(config);
+        thrust::for_each(team_sizes.begin(), team_sizes.end(), record_team_size());
+    }
+
+    ASSERT_EQUAL(thrust::reduce(team_sizes.begin(), team_sizes.end(), 0, thrust::maximum<int>()) <= 2, true);
+
+    config.num_threads   = 0;
+    config.serial_cutoff = 10001;
+
+    {
+        scoped_execution_config scope(config);
+        thrust::for_each(team_sizes.begin(), team_sizes.end(), record_team_size());
+    }
+
+    ASSERT_EQUAL(thrust::reduce(team_sizes.begin(), team_sizes.end(), 0, thrust::maximum<int>()), 1);
+
+    config.serial_cutoff           = 0;
+    config.min_elements_per_thread = 5000;
+
+    {
+        scoped_execution_config scope(config);
+        thrust::for_each(team_sizes.begin(), team_sizes.end(), record_team_size());
+    }
+
+    ASSERT_EQUAL(thrust::reduce(team_sizes.begin(), team_sizes.end(), 0, thrust::maximum<int>()) <= 2, true);
+
+    // the global OpenMP state is untouched
+    ASSERT_EQUAL(omp_get_max_threads(), max_threads);
+}
+DECLARE_UNITTEST(TestExecutionConfigNumThreads);
+
+template <typename T>
+void _TestExecutionConfigAlgorithms(const size_t n)
+{
+    using namespace thrust::omp;
+
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+
+    thrust::host_vector<T> h_sorted = h_data;
+    thrust::stable_sort(h_sorted.begin(), h_sorted.end());
+
+    thrust::host_vector<T> h_scan(n);
+    thrust::inclusive_scan(h_data.begin(), h_data.end(), h_scan.begin());
+
+    thrust::host_vector<T> h_evens(n);
+    h_evens.resize(thrust::copy_if(h_data.begin(), h_data.end(), h_evens.begin(), is_even<T>()) - h_evens.begin());
+
+    T h_sum = thrust::reduce(h_data.begin(), h_data.end());
+
+    schedule_kind schedules[] = {static_schedule, dynamic_schedule};
+    int num_threads[] = {1, 2, 3};
+    size_t serial_cutoffs[] = {0, n};
+
+    for (int s = 0; s < 2; s++)
+        for (int t = 0; t < 3; t++)
+            for (int c = 0; c < 2; c++)
+            {
+                execution_config config;
+                config.schedule                = schedules[s];
+                config.num_threads             = num_threads[t];
+                config.serial_cutoff           = serial_cutoffs[c];
+                config.min_elements_per_thread = 7;
+
+                scoped_execution_config scope(config);
+
+                thrust::device_vector<T> d_data = h_data;
+
+                ASSERT_EQUAL(thrust::reduce(d_data.begin(), d_data.end()), h_sum);
+
+                thrust::device_vector<T> d_scan(n);
+                thrust::inclusive_scan(d_data.begin(), d_data.end(), d_scan.begin());
+                ASSERT_EQUAL(d_scan, h_scan);
+
+                thrust::device_vector<T> d_evens(n);
+                d_evens.resize(thrust::copy_if(d_data.begin(), d_data.end(), d_evens.begin(), is_even<T>()) - d_evens.begin());
+                ASSERT_EQUAL(d_evens, h_evens);
+
+                thrust::stable_sort(d_data.begin(), d_data.end());
+                ASSERT_EQUAL(d_data, h_sorted);
+            }
+}
+
+void TestExecutionConfigAlgorithms(void)
+{
+    size_t sizes[] = {1, 2, 13, 1000, 12345};
+
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); i++)
+    {
+        _TestExecutionConfigAlgorithms<int>(sizes[i]);
+        _TestExecutionConfigAlgorithms<unsigned int>(sizes[i]);
+    }
+}
+DECLARE_UNITTEST(TestExecutionConfigAlgorithms);
+
+#endif // THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+
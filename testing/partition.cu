@@ -2,6 +2,9 @@
 #include <thrust/partition.h>
 
 #include <thrust/sort.h>
+#include <thrust/workspace.h>
+#include <thrust/device_malloc.h>
+#include <thrust/device_free.h>
 
 template<typename T>
 struct is_even
@@ -191,3 +194,32 @@ void TestStablePartitionCopy(const size_t n)
 }
 DECLARE_VARIABLE_UNITTEST(TestStablePartitionCopy);
 
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP && __THRUST_HAS_TEMPORARY_CACHE
+void TestStablePartitionInPlace(void)
+{
+    const size_t n = 100000;
+
+    thrust::host_vector<int>   h_data = unittest::random_integers<int>(n);
+    thrust::device_vector<int> d_data = h_data;
+
+    // the OpenMP stable_partition needs no more than a few bytes per thread
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(4096);
+
+    {
+        thrust::scoped_workspace workspace(region, 4096);
+
+        size_t h_size = thrust::stable_partition(h_data.begin(), h_data.end(), is_even<int>()) - h_data.begin();
+        size_t d_size = thrust::stable_partition(d_data.begin(), d_data.end(), is_even<int>()) - d_data.begin();
+
+        ASSERT_EQUAL(h_size, d_size);
+        ASSERT_EQUAL(workspace.bytes_in_use(), 0u);
+    }
+
+    ASSERT_EQUAL(h_data, d_data);
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestStablePartitionInPlace);
+#endif // THRUST_DEVICE_BACKEND_OMP
+
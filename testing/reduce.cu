@@ -1,5 +1,8 @@
 #include <unittest/unittest.h>
 #include <thrust/reduce.h>
+#include <thrust/functional.h>
+#include <thrust/pair.h>
+#include <thrust/execution_config.h>
 
 template<typename T>
 struct is_equal_div_10_reduce
@@ -172,6 +175,154 @@ void TestReduceWithIndirection(void)
 DECLARE_VECTOR_UNITTEST(TestReduceWithIndirection);
 
 
+// the OpenMP backend reduces arithmetic types in blocks of eight interleaved
+// lanes, and inputs shorter than 1 << 15 without a parallel region
+
+void TestReduceAroundSerialThreshold(void)
+{
+    const size_t threshold = 1 << 15;
+
+    size_t sizes[] = {threshold - 9, threshold - 1, threshold, threshold + 1, threshold + 7, 2 * threshold + 3};
+
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); i++)
+    {
+        const size_t n = sizes[i];
+
+        thrust::host_vector<unsigned int> h_data = unittest::random_integers<unsigned int>(n);
+
+        // small integers are summed exactly in floating point
+        thrust::host_vector<float> h_float(n);
+        for(size_t j = 0; j < n; j++)
+            h_float[j] = float(h_data[j] % 100);
+
+        thrust::device_vector<unsigned int> d_data  = h_data;
+        thrust::device_vector<float>        d_float = h_float;
+
+        ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), 13u), thrust::reduce(d_data.begin(), d_data.end(), 13u));
+        ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), 0u, thrust::maximum<unsigned int>()),
+                     thrust::reduce(d_data.begin(), d_data.end(), 0u, thrust::maximum<unsigned int>()));
+        ASSERT_EQUAL(thrust::reduce(h_float.begin(), h_float.end(), 0.5f), thrust::reduce(d_float.begin(), d_float.end(), 0.5f));
+    }
+}
+DECLARE_UNITTEST(TestReduceAroundSerialThreshold);
+
+void TestReduceShortTails(void)
+{
+    // sizes below two full rounds of the lanes, and ragged tails above
+    for(size_t n = 1; n <= 41; n++)
+    {
+        thrust::host_vector<int> h_data = unittest::random_integers<int>(n);
+
+        thrust::host_vector<double> h_double(n);
+        for(size_t j = 0; j < n; j++)
+            h_double[j] = double(j + 1);
+
+        thrust::device_vector<int>    d_data   = h_data;
+        thrust::device_vector<double> d_double = h_double;
+
+        ASSERT_EQUAL(thrust::reduce(d_double.begin(), d_double.end(), 0.5), 0.5 + double(n * (n + 1) / 2));
+        ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), 0, thrust::minimum<int>()),
+                     thrust::reduce(d_data.begin(), d_data.end(), 0, thrust::minimum<int>()));
+        ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), 0, thrust::maximum<int>()),
+                     thrust::reduce(d_data.begin(), d_data.end(), 0, thrust::maximum<int>()));
+    }
+}
+DECLARE_UNITTEST(TestReduceShortTails);
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+
+void TestReduceDeterministicBlocks(void)
+{
+    using namespace thrust::omp;
+
+    // several deterministic blocks, the last one partial
+    const size_t n = 5 * (1 << 12) + 3;
+
+    thrust::host_vector<float>   h_data = unittest::random_samples<float>(n);
+    thrust::device_vector<float> d_data = h_data;
+
+    scoped_deterministic_reductions deterministic;
+
+    execution_config config;
+    config.num_threads = 1;
+
+    float reference;
+
+    {
+        scoped_execution_config scope(config);
+        reference = thrust::reduce(d_data.begin(), d_data.end(), 0.0f);
+    }
+
+    ASSERT_ALMOST_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), 0.0f), reference);
+
+    for(int num_threads = 2; num_threads <= 4; num_threads++)
+    {
+        config.num_threads = num_threads;
+
+        scoped_execution_config scope(config);
+
+        ASSERT_EQUAL(thrust::reduce(d_data.begin(), d_data.end(), 0.0f), reference);
+    }
+}
+DECLARE_UNITTEST(TestReduceDeterministicBlocks);
+
+// composes the affine maps x -> a.first * x + a.second and then
+// x -> b.first * x + b.second; associative but not commutative
+struct compose_affine
+{
+    __host__ __device__
+    thrust::pair<unsigned int,unsigned int> operator()(const thrust::pair<unsigned int,unsigned int>& a,
+                                                       const thrust::pair<unsigned int,unsigned int>& b) const
+    {
+        return thrust::make_pair(a.first * b.first, a.second * b.first + b.second);
+    }
+};
+
+void TestReduceDeterministicCombinesBlocksInOrder(void)
+{
+    using namespace thrust::omp;
+
+    typedef thrust::pair<unsigned int,unsigned int> T;
+
+    // several deterministic blocks, the last one partial.  pairs take the
+    // general path, which reduces each block element by element, so only
+    // the order in which the blocks are combined is left to check
+    const size_t n = 5 * (1 << 12) + 3;
+
+    thrust::host_vector<unsigned int> h_a = unittest::random_integers<unsigned int>(n);
+
+    thrust::host_vector<T> h_data(n);
+
+    for(size_t i = 0; i < n; i++)
+        h_data[i] = thrust::make_pair(h_a[i] | 1u, h_a[(i + 1) % n]);
+
+    thrust::device_vector<T> d_data = h_data;
+
+    T reference = thrust::make_pair(1u, 0u);
+
+    for(size_t i = 0; i < n; i++)
+        reference = compose_affine()(reference, h_data[i]);
+
+    scoped_deterministic_reductions deterministic;
+
+    for(int num_threads = 1; num_threads <= 4; num_threads++)
+    {
+        execution_config config;
+        config.num_threads = num_threads;
+
+        scoped_execution_config scope(config);
+
+        T result = thrust::reduce(d_data.begin(), d_data.end(), thrust::make_pair(1u, 0u), compose_affine());
+
+        ASSERT_EQUAL(result.first,  reference.first);
+        ASSERT_EQUAL(result.second, reference.second);
+    }
+}
+DECLARE_UNITTEST(TestReduceDeterministicCombinesBlocksInOrder);
+
+#endif // THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+
+
 
 template <typename Vector>
 void initialize_keys(Vector& keys)
@@ -316,3 +467,72 @@ struct TestReduceByKey
 };
 VariableUnitTest<TestReduceByKey, IntegralTypes> TestReduceByKeyInstance;
 
+template<typename K>
+struct TestReduceByKeyLongSegments
+{
+    void operator()(const size_t n)
+    {
+        typedef unsigned int V; // ValueType
+
+        // long runs of equal keys, so that segments span several blocks of work
+        thrust::host_vector<K>   h_keys(n);
+        thrust::host_vector<V>   h_vals = unittest::random_integers<V>(n);
+
+        for(size_t i = 0; i < n; i++)
+            h_keys[i] = static_cast<K>((i * 7) / (n + 1));
+
+        thrust::device_vector<K> d_keys = h_keys;
+        thrust::device_vector<V> d_vals = h_vals;
+
+        thrust::host_vector<K>   h_keys_output(n);
+        thrust::host_vector<V>   h_vals_output(n);
+        thrust::device_vector<K> d_keys_output(n);
+        thrust::device_vector<V> d_vals_output(n);
+
+        typedef typename thrust::host_vector<K>::iterator   HostKeyIterator;
+        typedef typename thrust::host_vector<V>::iterator   HostValIterator;
+        typedef typename thrust::device_vector<K>::iterator DeviceKeyIterator;
+        typedef typename thrust::device_vector<V>::iterator DeviceValIterator;
+
+        typedef typename thrust::pair<HostKeyIterator,  HostValIterator>   HostIteratorPair;
+        typedef typename thrust::pair<DeviceKeyIterator,DeviceValIterator> DeviceIteratorPair;
+
+        // project2nd is not commutative; it yields the last value of each segment
+        HostIteratorPair   h_last = thrust::reduce_by_key(h_keys.begin(), h_keys.end(), h_vals.begin(), h_keys_output.begin(), h_vals_output.begin(),
+                                                          thrust::equal_to<K>(), thrust::project2nd<V,V>());
+        DeviceIteratorPair d_last = thrust::reduce_by_key(d_keys.begin(), d_keys.end(), d_vals.begin(), d_keys_output.begin(), d_vals_output.begin(),
+                                                          thrust::equal_to<K>(), thrust::project2nd<V,V>());
+
+        ASSERT_EQUAL(h_last.first  - h_keys_output.begin(), d_last.first  - d_keys_output.begin());
+        ASSERT_EQUAL(h_last.second - h_vals_output.begin(), d_last.second - d_vals_output.begin());
+
+        size_t N = h_last.first - h_keys_output.begin();
+
+        h_keys_output.resize(N);
+        h_vals_output.resize(N);
+        d_keys_output.resize(N);
+        d_vals_output.resize(N);
+
+        ASSERT_EQUAL(h_keys_output, d_keys_output);
+        ASSERT_EQUAL(h_vals_output, d_vals_output);
+
+        // sums
+        h_keys_output.resize(n);  h_vals_output.resize(n);
+        d_keys_output.resize(n);  d_vals_output.resize(n);
+
+        h_last = thrust::reduce_by_key(h_keys.begin(), h_keys.end(), h_vals.begin(), h_keys_output.begin(), h_vals_output.begin());
+        d_last = thrust::reduce_by_key(d_keys.begin(), d_keys.end(), d_vals.begin(), d_keys_output.begin(), d_vals_output.begin());
+
+        N = h_last.first - h_keys_output.begin();
+
+        h_keys_output.resize(N);
+        h_vals_output.resize(N);
+        d_keys_output.resize(N);
+        d_vals_output.resize(N);
+
+        ASSERT_EQUAL(h_keys_output, d_keys_output);
+        ASSERT_EQUAL(h_vals_output, d_vals_output);
+    }
+};
+VariableUnitTest<TestReduceByKeyLongSegments, IntegralTypes> TestReduceByKeyLongSegmentsInstance;
+
@@ -1,5 +1,10 @@
 #include <unittest/unittest.h>
 #include <thrust/remove.h>
+#include <thrust/workspace.h>
+#include <thrust/device_malloc.h>
+#include <thrust/device_free.h>
+#include <thrust/execution_config.h>
+#include <thrust/sequence.h>
 #include <stdexcept>
 
 template<typename T>
@@ -324,4 +329,87 @@ void TestRemoveCopyIfStencil(const size_t n)
 DECLARE_VARIABLE_UNITTEST(TestRemoveCopyIfStencil);
 
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP && __THRUST_HAS_TEMPORARY_CACHE
+void TestRemoveIfInPlace(void)
+{
+    const size_t n = 100000;
+
+    thrust::host_vector<int>   h_data    = unittest::random_integers<int>(n);
+    thrust::host_vector<bool>  h_stencil = unittest::random_integers<bool>(n);
+    thrust::device_vector<int> d_data    = h_data;
+    thrust::device_vector<bool> d_stencil = h_stencil;
+
+    // the OpenMP remove_if needs no more than a few bytes per thread
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(4096);
+
+    {
+        thrust::scoped_workspace workspace(region, 4096);
+
+        size_t h_size = thrust::remove_if(h_data.begin(), h_data.end(), is_even_remove<int>()) - h_data.begin();
+        size_t d_size = thrust::remove_if(d_data.begin(), d_data.end(), is_even_remove<int>()) - d_data.begin();
+
+        ASSERT_EQUAL(h_size, d_size);
+
+        h_size = thrust::remove_if(h_data.begin(), h_data.begin() + h_size, h_stencil.begin(), is_true_remove<bool>()) - h_data.begin();
+        d_size = thrust::remove_if(d_data.begin(), d_data.begin() + d_size, d_stencil.begin(), is_true_remove<bool>()) - d_data.begin();
+
+        ASSERT_EQUAL(h_size, d_size);
+        ASSERT_EQUAL(workspace.bytes_in_use(), 0u);
+
+        h_data.resize(h_size);
+        d_data.resize(d_size);
+    }
+
+    ASSERT_EQUAL(h_data, d_data);
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestRemoveIfInPlace);
+
+template<typename T>
+struct is_multiple_remove
+{
+    T m;
+
+    is_multiple_remove(T m) : m(m) {}
+
+    __host__ __device__
+    bool operator()(T x) { return (x % m) == 0; }
+};
+
+void TestRemoveIfShiftDistances(void)
+{
+    using namespace thrust::omp;
+
+    const int n = 1 << 18;
+
+    thrust::host_vector<int> h_data(n);
+    thrust::sequence(h_data.begin(), h_data.end());
+
+    // removing every 1000th element moves the blocks a short distance,
+    // every 10th further than a thread's part of a round, and every 2nd
+    // further than they are long
+    int moduli[] = {1000, 10, 2};
+
+    for(int i = 0; i < 3; i++)
+    {
+        thrust::host_vector<int> h_result = h_data;
+        h_result.resize(thrust::remove_if(h_result.begin(), h_result.end(), is_multiple_remove<int>(moduli[i])) - h_result.begin());
+
+        for(int num_threads = 1; num_threads <= 4; num_threads++)
+        {
+            execution_config config;
+            config.num_threads = num_threads;
+
+            scoped_execution_config scope(config);
+
+            thrust::device_vector<int> d_result = h_data;
+            d_result.resize(thrust::remove_if(d_result.begin(), d_result.end(), is_multiple_remove<int>(moduli[i])) - d_result.begin());
+
+            ASSERT_EQUAL(h_result, d_result);
+        }
+    }
+}
+DECLARE_UNITTEST(TestRemoveIfShiftDistances);
+#endif // THRUST_DEVICE_BACKEND_OMP
 
@@ -1,6 +1,7 @@
 #include <unittest/unittest.h>
 #include <thrust/scan.h>
 #include <thrust/functional.h>
+#include <thrust/iterator/zip_iterator.h>
 
 template <class Vector>
 void TestScanSimple(void)
@@ -251,6 +252,86 @@ struct TestScan
 VariableUnitTest<TestScan, IntegralTypes> TestScanInstance;
 
 
+// composition of affine functions x -> a * x + b is associative but not commutative
+template <typename Tuple>
+struct compose_affine
+{
+  __host__ __device__
+  Tuple operator()(Tuple f, Tuple g) const
+  {
+    return thrust::make_tuple(thrust::get<0>(f) * thrust::get<0>(g),
+                              thrust::get<1>(f) * thrust::get<0>(g) + thrust::get<1>(g));
+  }
+};
+
+template <typename T>
+struct TestScanNonCommutative
+{
+  void operator()(const size_t n)
+  {
+    typedef thrust::tuple<T,T> Tuple;
+
+    thrust::host_vector<T>   h_a = unittest::random_integers<T>(n);
+    thrust::host_vector<T>   h_b = unittest::random_integers<T>(n);
+    thrust::device_vector<T> d_a = h_a;
+    thrust::device_vector<T> d_b = h_b;
+
+    thrust::host_vector<T>   h_result_a(n), h_result_b(n);
+    thrust::device_vector<T> d_result_a(n), d_result_b(n);
+
+    thrust::inclusive_scan(thrust::make_zip_iterator(thrust::make_tuple(h_a.begin(), h_b.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(h_a.end(),   h_b.end())),
+                           thrust::make_zip_iterator(thrust::make_tuple(h_result_a.begin(), h_result_b.begin())),
+                           compose_affine<Tuple>());
+    thrust::inclusive_scan(thrust::make_zip_iterator(thrust::make_tuple(d_a.begin(), d_b.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(d_a.end(),   d_b.end())),
+                           thrust::make_zip_iterator(thrust::make_tuple(d_result_a.begin(), d_result_b.begin())),
+                           compose_affine<Tuple>());
+    ASSERT_EQUAL(d_result_a, h_result_a);
+    ASSERT_EQUAL(d_result_b, h_result_b);
+    
+    thrust::exclusive_scan(thrust::make_zip_iterator(thrust::make_tuple(h_a.begin(), h_b.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(h_a.end(),   h_b.end())),
+                           thrust::make_zip_iterator(thrust::make_tuple(h_result_a.begin(), h_result_b.begin())),
+                           thrust::make_tuple<T,T>(3,7),
+                           compose_affine<Tuple>());
+    thrust::exclusive_scan(thrust::make_zip_iterator(thrust::make_tuple(d_a.begin(), d_b.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(d_a.end(),   d_b.end())),
+                           thrust::make_zip_iterator(thrust::make_tuple(d_result_a.begin(), d_result_b.begin())),
+                           thrust::make_tuple<T,T>(3,7),
+                           compose_affine<Tuple>());
+    ASSERT_EQUAL(d_result_a, h_result_a);
+    ASSERT_EQUAL(d_result_b, h_result_b);
+    
+    // in-place scans
+    thrust::inclusive_scan(thrust::make_zip_iterator(thrust::make_tuple(h_a.begin(), h_b.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(h_a.end(),   h_b.end())),
+                           thrust::make_zip_iterator(thrust::make_tuple(h_a.begin(), h_b.begin())),
+                           compose_affine<Tuple>());
+    thrust::inclusive_scan(thrust::make_zip_iterator(thrust::make_tuple(d_a.begin(), d_b.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(d_a.end(),   d_b.end())),
+                           thrust::make_zip_iterator(thrust::make_tuple(d_a.begin(), d_b.begin())),
+                           compose_affine<Tuple>());
+    ASSERT_EQUAL(d_a, h_a);
+    ASSERT_EQUAL(d_b, h_b);
+    
+    thrust::exclusive_scan(thrust::make_zip_iterator(thrust::make_tuple(h_a.begin(), h_b.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(h_a.end(),   h_b.end())),
+                           thrust::make_zip_iterator(thrust::make_tuple(h_a.begin(), h_b.begin())),
+                           thrust::make_tuple<T,T>(3,7),
+                           compose_affine<Tuple>());
+    thrust::exclusive_scan(thrust::make_zip_iterator(thrust::make_tuple(d_a.begin(), d_b.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(d_a.end(),   d_b.end())),
+                           thrust::make_zip_iterator(thrust::make_tuple(d_a.begin(), d_b.begin())),
+                           thrust::make_tuple<T,T>(3,7),
+                           compose_affine<Tuple>());
+    ASSERT_EQUAL(d_a, h_a);
+    ASSERT_EQUAL(d_b, h_b);
+  }
+};
+VariableUnitTest<TestScanNonCommutative, UnsignedIntegralTypes> TestScanNonCommutativeInstance;
+
+
 void TestScanMixedTypes(void)
 {
     const unsigned int n = 113;
@@ -0,0 +1,70 @@
+#include <unittest/unittest.h>
+#include <thrust/experimental/search_index.h>
+#include <thrust/binary_search.h>
+#include <thrust/sort.h>
+
+template <typename T>
+struct TestSearchIndex
+{
+  void operator()(const size_t n)
+  {
+    thrust::host_vector<T>   h_vec = unittest::random_integers<T>(n);
+    thrust::device_vector<T> d_vec = h_vec;
+
+    thrust::sort(h_vec.begin(), h_vec.end());
+    thrust::sort(d_vec.begin(), d_vec.end());
+
+    thrust::experimental::search_index<typename thrust::device_vector<T>::iterator> index(d_vec.begin(), d_vec.end());
+
+    ASSERT_EQUAL(index.size(), (int) n);
+
+    thrust::host_vector<T>   h_input = unittest::random_integers<T>(4*n);
+    thrust::device_vector<T> d_input = h_input;
+    
+    thrust::host_vector<int>   h_output(4*n);
+    thrust::device_vector<int> d_output(4*n);
+
+    thrust::lower_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+    thrust::experimental::lower_bound(index, d_input.begin(), d_input.end(), d_output.begin());
+
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::upper_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+    thrust::experimental::upper_bound(index, d_input.begin(), d_input.end(), d_output.begin());
+
+    ASSERT_EQUAL(h_output, d_output);
+  }
+};
+VariableUnitTest<TestSearchIndex, IntegralTypes> TestSearchIndexInstance;
+
+
+void TestSearchIndexComparison(void)
+{
+  const size_t n = 10000;
+
+  thrust::host_vector<float>   h_vec = unittest::random_samples<float>(n);
+  thrust::device_vector<float> d_vec = h_vec;
+
+  thrust::sort(h_vec.begin(), h_vec.end(), thrust::greater<float>());
+  thrust::sort(d_vec.begin(), d_vec.end(), thrust::greater<float>());
+
+  typedef thrust::experimental::search_index<thrust::device_vector<float>::iterator, thrust::greater<float> > index_type;
+
+  index_type index(d_vec.begin(), d_vec.end(), thrust::greater<float>());
+
+  // search for every element, so that runs of equal elements are found
+  thrust::host_vector<int>   h_output(n);
+  thrust::device_vector<int> d_output(n);
+
+  thrust::lower_bound(h_vec.begin(), h_vec.end(), h_vec.begin(), h_vec.end(), h_output.begin(), thrust::greater<float>());
+  index.lower_bound(d_vec.begin(), d_vec.end(), d_output.begin());
+
+  ASSERT_EQUAL(h_output, d_output);
+
+  thrust::upper_bound(h_vec.begin(), h_vec.end(), h_vec.begin(), h_vec.end(), h_output.begin(), thrust::greater<float>());
+  index.upper_bound(d_vec.begin(), d_vec.end(), d_output.begin());
+
+  ASSERT_EQUAL(h_output, d_output);
+}
+DECLARE_UNITTEST(TestSearchIndexComparison);
+
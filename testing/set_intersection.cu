@@ -3,6 +3,7 @@
 #include <thrust/functional.h>
 #include <thrust/sort.h>
 #include <thrust/count.h>
+#include <thrust/sequence.h>
 
 
 template<typename Vector>
@@ -278,3 +279,135 @@ void TestSetIntersectionNonArithmetic(void)
 DECLARE_UNITTEST(TestSetIntersectionNonArithmetic);
 
 
+
+
+struct compare_tens
+{
+  __host__ __device__
+  bool operator()(int x, int y) const
+  {
+    return (x / 10) < (y / 10);
+  }
+};
+
+
+void TestSetIntersectionStability(void)
+{
+  const size_t n = 12345;
+
+  // elements with the same tens digit are equivalent; the intersection
+  // must consist of the leading elements of each run in the first range
+  thrust::host_vector<int> temp = unittest::random_integers<int>(2 * n);
+
+  for(size_t i = 0; i < temp.size(); ++i)
+  {
+    temp[i] = static_cast<unsigned int>(temp[i]) % 1000;
+  }
+
+  thrust::host_vector<int> h_a(temp.begin(), temp.begin() + n);
+  thrust::host_vector<int> h_b(temp.begin() + n, temp.end());
+
+  thrust::stable_sort(h_a.begin(), h_a.end(), compare_tens());
+  thrust::stable_sort(h_b.begin(), h_b.end(), compare_tens());
+
+  thrust::device_vector<int> d_a = h_a;
+  thrust::device_vector<int> d_b = h_b;
+
+  thrust::host_vector<int> h_result(n);
+  thrust::device_vector<int> d_result(n);
+
+  thrust::host_vector<int>::iterator h_end;
+  thrust::device_vector<int>::iterator d_end;
+
+  h_end = thrust::set_intersection(h_a.begin(), h_a.end(),
+                                   h_b.begin(), h_b.end(),
+                                   h_result.begin(),
+                                   compare_tens());
+  h_result.resize(h_end - h_result.begin());
+
+  d_end = thrust::set_intersection(d_a.begin(), d_a.end(),
+                                   d_b.begin(), d_b.end(),
+                                   d_result.begin(),
+                                   compare_tens());
+  d_result.resize(d_end - d_result.begin());
+
+  ASSERT_EQUAL(h_result, d_result);
+}
+DECLARE_UNITTEST(TestSetIntersectionStability);
+
+
+template<typename T>
+void TestSetIntersectionByKey(const size_t n)
+{
+  thrust::host_vector<T> temp = unittest::random_integers<T>(2 * n);
+
+  // restrict keys to [min,13) so that the ranges share many keys
+  for(typename thrust::host_vector<T>::iterator i = temp.begin();
+      i != temp.end();
+      ++i)
+  {
+    int temp = static_cast<int>(*i);
+    temp %= 13;
+    *i = temp;
+  }
+
+  thrust::host_vector<T> h_a_keys(temp.begin(), temp.begin() + n);
+  thrust::host_vector<T> h_b_keys(temp.begin() + n, temp.end());
+
+  thrust::sort(h_a_keys.begin(), h_a_keys.end());
+  thrust::sort(h_b_keys.begin(), h_b_keys.end());
+
+  // values record where each element came from
+  thrust::host_vector<int> h_a_vals(n);
+  thrust::host_vector<int> h_b_vals(n);
+  thrust::sequence(h_a_vals.begin(), h_a_vals.end(), 0);
+  thrust::sequence(h_b_vals.begin(), h_b_vals.end(), static_cast<int>(n));
+
+  thrust::device_vector<T>   d_a_keys = h_a_keys;
+  thrust::device_vector<T>   d_b_keys = h_b_keys;
+  thrust::device_vector<int> d_a_vals = h_a_vals;
+  thrust::device_vector<int> d_b_vals = h_b_vals;
+
+  thrust::host_vector<T>     h_ref(2 * n);
+  thrust::host_vector<T>     h_result_keys(2 * n);
+  thrust::host_vector<int>   h_result_vals(2 * n);
+  thrust::device_vector<T>   d_result_keys(2 * n);
+  thrust::device_vector<int> d_result_vals(2 * n);
+
+  h_ref.resize(thrust::set_intersection(h_a_keys.begin(), h_a_keys.end(),
+                                        h_b_keys.begin(), h_b_keys.end(),
+                                        h_ref.begin()) - h_ref.begin());
+
+  thrust::pair<typename thrust::host_vector<T>::iterator,
+               thrust::host_vector<int>::iterator> h_end;
+
+  thrust::pair<typename thrust::device_vector<T>::iterator,
+               thrust::device_vector<int>::iterator> d_end;
+
+  h_end = thrust::set_intersection_by_key(h_a_keys.begin(), h_a_keys.end(),
+                                          h_b_keys.begin(), h_b_keys.end(),
+                                          h_a_vals.begin(), h_b_vals.begin(),
+                                          h_result_keys.begin(), h_result_vals.begin());
+  h_result_keys.resize(h_end.first  - h_result_keys.begin());
+  h_result_vals.resize(h_end.second - h_result_vals.begin());
+
+  d_end = thrust::set_intersection_by_key(d_a_keys.begin(), d_a_keys.end(),
+                                          d_b_keys.begin(), d_b_keys.end(),
+                                          d_a_vals.begin(), d_b_vals.begin(),
+                                          d_result_keys.begin(), d_result_vals.begin());
+  d_result_keys.resize(d_end.first  - d_result_keys.begin());
+  d_result_vals.resize(d_end.second - d_result_vals.begin());
+
+  ASSERT_EQUAL(h_ref, h_result_keys);
+  ASSERT_EQUAL(h_result_keys, d_result_keys);
+  ASSERT_EQUAL(h_result_vals, d_result_vals);
+
+  // every value must accompany its own key
+  for(size_t i = 0; i < h_result_keys.size(); i++)
+  {
+    int v = h_result_vals[i];
+    T key = (v < static_cast<int>(n)) ? h_a_keys[v] : h_b_keys[v - n];
+    ASSERT_EQUAL(h_result_keys[i], key);
+  }
+}
+DECLARE_VARIABLE_UNITTEST(TestSetIntersectionByKey);
@@ -0,0 +1,189 @@
+#include <unittest/unittest.h>
+#include <thrust/set_symmetric_difference.h>
+#include <thrust/functional.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+
+template<typename Vector>
+void TestSetSymmetricDifferenceSimple(void)
+{
+  typedef typename Vector::iterator Iterator;
+
+  Vector a(3), b(4);
+
+  a[0] = 0; a[1] = 2; a[2] = 4;
+  b[0] = 0; b[1] = 3; b[2] = 3; b[3] = 4;
+
+  Vector ref(3);
+  ref[0] = 2; ref[1] = 3; ref[2] = 3;
+
+  Vector result(3);
+
+  Iterator end = thrust::set_symmetric_difference(a.begin(), a.end(),
+                                                  b.begin(), b.end(),
+                                                  result.begin());
+
+  ASSERT_EQUAL_QUIET(result.end(), end);
+  ASSERT_EQUAL(ref, result);
+}
+DECLARE_VECTOR_UNITTEST(TestSetSymmetricDifferenceSimple);
+
+
+template<typename T>
+void TestSetSymmetricDifference(const size_t n)
+{
+  thrust::host_vector<T> temp = unittest::random_integers<T>(2 * n);
+
+  thrust::host_vector<T> h_a(temp.begin(), temp.begin() + n);
+  thrust::host_vector<T> h_b(temp.begin() + n, temp.end());
+
+  thrust::sort(h_a.begin(), h_a.end());
+  thrust::sort(h_b.begin(), h_b.end());
+
+  thrust::device_vector<T> d_a = h_a;
+  thrust::device_vector<T> d_b = h_b;
+
+  thrust::host_vector<T> h_result(2 * n);
+  thrust::device_vector<T> d_result(2 * n);
+
+  typename thrust::host_vector<T>::iterator h_end;
+  typename thrust::device_vector<T>::iterator d_end;
+  
+  h_end = thrust::set_symmetric_difference(h_a.begin(), h_a.end(),
+                                           h_b.begin(), h_b.end(),
+                                           h_result.begin());
+  h_result.resize(h_end - h_result.begin());
+
+  d_end = thrust::set_symmetric_difference(d_a.begin(), d_a.end(),
+                                           d_b.begin(), d_b.end(),
+                                           d_result.begin());
+
+  d_result.resize(d_end - d_result.begin());
+
+  ASSERT_EQUAL(h_result, d_result);
+}
+DECLARE_VARIABLE_UNITTEST(TestSetSymmetricDifference);
+
+
+template<typename T>
+void TestSetSymmetricDifferenceMultiset(const size_t n)
+{
+  thrust::host_vector<T> temp = unittest::random_integers<T>(2 * n);
+
+  // restrict elements to [min,13)
+  for(typename thrust::host_vector<T>::iterator i = temp.begin();
+      i != temp.end();
+      ++i)
+  {
+    int temp = static_cast<int>(*i);
+    temp %= 13;
+    *i = temp;
+  }
+
+  thrust::host_vector<T> h_a(temp.begin(), temp.begin() + n);
+  thrust::host_vector<T> h_b(temp.begin() + n, temp.end());
+
+  thrust::sort(h_a.begin(), h_a.end());
+  thrust::sort(h_b.begin(), h_b.end());
+
+  thrust::device_vector<T> d_a = h_a;
+  thrust::device_vector<T> d_b = h_b;
+
+  thrust::host_vector<T> h_result(2 * n);
+  thrust::device_vector<T> d_result(2 * n);
+
+  typename thrust::host_vector<T>::iterator h_end;
+  typename thrust::device_vector<T>::iterator d_end;
+  
+  h_end = thrust::set_symmetric_difference(h_a.begin(), h_a.end(),
+                                           h_b.begin(), h_b.end(),
+                                           h_result.begin());
+  h_result.resize(h_end - h_result.begin());
+
+  d_end = thrust::set_symmetric_difference(d_a.begin(), d_a.end(),
+                                           d_b.begin(), d_b.end(),
+                                           d_result.begin());
+
+  d_result.resize(d_end - d_result.begin());
+
+  ASSERT_EQUAL(h_result, d_result);
+}
+DECLARE_VARIABLE_UNITTEST(TestSetSymmetricDifferenceMultiset);
+
+
+template<typename T>
+void TestSetSymmetricDifferenceByKey(const size_t n)
+{
+  thrust::host_vector<T> temp = unittest::random_integers<T>(2 * n);
+
+  // restrict keys to [min,13) so that the ranges share many keys
+  for(typename thrust::host_vector<T>::iterator i = temp.begin();
+      i != temp.end();
+      ++i)
+  {
+    int temp = static_cast<int>(*i);
+    temp %= 13;
+    *i = temp;
+  }
+
+  thrust::host_vector<T> h_a_keys(temp.begin(), temp.begin() + n);
+  thrust::host_vector<T> h_b_keys(temp.begin() + n, temp.end());
+
+  thrust::sort(h_a_keys.begin(), h_a_keys.end());
+  thrust::sort(h_b_keys.begin(), h_b_keys.end());
+
+  // values record where each element came from
+  thrust::host_vector<int> h_a_vals(n);
+  thrust::host_vector<int> h_b_vals(n);
+  thrust::sequence(h_a_vals.begin(), h_a_vals.end(), 0);
+  thrust::sequence(h_b_vals.begin(), h_b_vals.end(), static_cast<int>(n));
+
+  thrust::device_vector<T>   d_a_keys = h_a_keys;
+  thrust::device_vector<T>   d_b_keys = h_b_keys;
+  thrust::device_vector<int> d_a_vals = h_a_vals;
+  thrust::device_vector<int> d_b_vals = h_b_vals;
+
+  thrust::host_vector<T>     h_ref(2 * n);
+  thrust::host_vector<T>     h_result_keys(2 * n);
+  thrust::host_vector<int>   h_result_vals(2 * n);
+  thrust::device_vector<T>   d_result_keys(2 * n);
+  thrust::device_vector<int> d_result_vals(2 * n);
+
+  h_ref.resize(thrust::set_symmetric_difference(h_a_keys.begin(), h_a_keys.end(),
+                                                h_b_keys.begin(), h_b_keys.end(),
+                                                h_ref.begin()) - h_ref.begin());
+
+  thrust::pair<typename thrust::host_vector<T>::iterator,
+               thrust::host_vector<int>::iterator> h_end;
+
+  thrust::pair<typename thrust::device_vector<T>::iterator,
+               thrust::device_vector<int>::iterator> d_end;
+
+  h_end = thrust::set_symmetric_difference_by_key(h_a_keys.begin(), h_a_keys.end(),
+                                                  h_b_keys.begin(), h_b_keys.end(),
+                                                  h_a_vals.begin(), h_b_vals.begin(),
+                                                  h_result_keys.begin(), h_result_vals.begin());
+  h_result_keys.resize(h_end.first  - h_result_keys.begin());
+  h_result_vals.resize(h_end.second - h_result_vals.begin());
+
+  d_end = thrust::set_symmetric_difference_by_key(d_a_keys.begin(), d_a_keys.end(),
+                                                  d_b_keys.begin(), d_b_keys.end(),
+                                                  d_a_vals.begin(), d_b_vals.begin(),
+                                                  d_result_keys.begin(), d_result_vals.begin());
+  d_result_keys.resize(d_end.first  - d_result_keys.begin());
+  d_result_vals.resize(d_end.second - d_result_vals.begin());
+
+  ASSERT_EQUAL(h_ref, h_result_keys);
+  ASSERT_EQUAL(h_result_keys, d_result_keys);
+  ASSERT_EQUAL(h_result_vals, d_result_vals);
+
+  // every value must accompany its own key
+  for(size_t i = 0; i < h_result_keys.size(); i++)
+  {
+    int v = h_result_vals[i];
+    T key = (v < static_cast<int>(n)) ? h_a_keys[v] : h_b_keys[v - n];
+    ASSERT_EQUAL(h_result_keys[i], key);
+  }
+}
+DECLARE_VARIABLE_UNITTEST(TestSetSymmetricDifferenceByKey);
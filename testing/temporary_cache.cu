@@ -0,0 +1,123 @@
+#include <unittest/unittest.h>
+#include <thrust/temporary_cache.h>
+#include <thrust/detail/raw_buffer.h>
+
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA && __THRUST_HAS_TEMPORARY_CACHE
+
+typedef thrust::detail::raw_buffer<int, thrust::device_space_tag> temporary_cache_buffer;
+
+void TestTemporaryCacheReuse(void)
+{
+    const std::size_t old_limit = thrust::temporary_cache::limit();
+    thrust::temporary_cache::set_limit(1 << 20);
+    thrust::temporary_cache::trim();
+
+    int *first = 0;
+    {
+        temporary_cache_buffer buffer(1000);
+        first = thrust::raw_pointer_cast(&*buffer.begin());
+    }
+
+    // the block is rounded up to 4096 bytes and kept
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 4096u);
+
+    {
+        // a request in the same size class reuses the block
+        temporary_cache_buffer buffer(900);
+        ASSERT_EQUAL(thrust::raw_pointer_cast(&*buffer.begin()) == first, true);
+        ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 0u);
+    }
+
+    thrust::temporary_cache::trim();
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 0u);
+
+    thrust::temporary_cache::set_limit(old_limit);
+}
+DECLARE_UNITTEST(TestTemporaryCacheReuse);
+
+void TestTemporaryCacheLimit(void)
+{
+    const std::size_t old_limit = thrust::temporary_cache::limit();
+    thrust::temporary_cache::trim();
+    thrust::temporary_cache::set_limit(8192);
+
+    {
+        temporary_cache_buffer a(1024);
+        temporary_cache_buffer b(1024);
+        temporary_cache_buffer c(1024);
+    }
+
+    // only two 4096-byte blocks fit below the limit
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 8192u);
+
+    // lowering the limit releases blocks above it
+    thrust::temporary_cache::set_limit(4096);
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 4096u);
+
+    // a limit of zero disables caching
+    thrust::temporary_cache::set_limit(0);
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 0u);
+    {
+        temporary_cache_buffer a(1024);
+    }
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 0u);
+
+    thrust::temporary_cache::set_limit(old_limit);
+}
+DECLARE_UNITTEST(TestTemporaryCacheLimit);
+
+void TestTemporaryCacheSizeClasses(void)
+{
+    const std::size_t old_limit = thrust::temporary_cache::limit();
+    thrust::temporary_cache::trim();
+    thrust::temporary_cache::set_limit(std::size_t(1) << 30);
+
+    {
+        // 5200 bytes lie in the second of four classes above 4096 bytes
+        temporary_cache_buffer buffer(1300);
+    }
+
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 6144u);
+
+    thrust::temporary_cache::trim();
+
+    {
+        // blocks above 64 MB take their exact size and are not kept
+        temporary_cache_buffer buffer((std::size_t(64) << 20) / sizeof(int) + 1);
+    }
+
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 0u);
+
+    thrust::temporary_cache::set_limit(old_limit);
+}
+DECLARE_UNITTEST(TestTemporaryCacheSizeClasses);
+
+void TestTemporaryCacheLimitRaised(void)
+{
+    const std::size_t old_limit = thrust::temporary_cache::limit();
+    thrust::temporary_cache::trim();
+    thrust::temporary_cache::set_limit(0);
+
+    {
+        // allocated at its exact size while the limit is zero
+        temporary_cache_buffer a(1000);
+
+        thrust::temporary_cache::set_limit(1 << 20);
+    }
+
+    // so it is not cached even though the limit has been raised
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 0u);
+
+    {
+        temporary_cache_buffer b(1000);
+    }
+
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 4096u);
+
+    thrust::temporary_cache::trim();
+    thrust::temporary_cache::set_limit(old_limit);
+}
+DECLARE_UNITTEST(TestTemporaryCacheLimitRaised);
+
+#endif // THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+
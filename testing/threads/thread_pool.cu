@@ -0,0 +1,126 @@
+#include <unittest/unittest.h>
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+
+#include <thrust/detail/device/threads/detail/thread_pool.h>
+#include <thrust/detail/device/threads/detail/parallel_for.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace unittest;
+using thrust::detail::device::threads::detail::task_group;
+
+// computes the nth Fibonacci number with one task per call
+struct fibonacci_task
+{
+    int n;
+    long *result;
+
+    fibonacci_task(int n, long *result) : n(n), result(result) {}
+
+    void operator()() const
+    {
+        if (n < 2)
+        {
+            *result = n;
+            return;
+        }
+
+        long x, y;
+
+        task_group group;
+        group.run(fibonacci_task(n - 1, &x));
+        fibonacci_task(n - 2, &y)();
+        group.wait();
+
+        *result = x + y;
+    }
+};
+
+void TestTaskGroupNested(void)
+{
+    long result = 0;
+
+    fibonacci_task(20, &result)();
+
+    ASSERT_EQUAL(result, 6765);
+}
+DECLARE_UNITTEST(TestTaskGroupNested);
+
+
+struct throw_if_odd
+{
+    int i;
+
+    throw_if_odd(int i) : i(i) {}
+
+    void operator()() const
+    {
+        if (i % 2)
+            throw std::runtime_error("odd");
+    }
+};
+
+void TestTaskGroupException(void)
+{
+    task_group group;
+
+    for (int i = 0; i < 100; i++)
+        group.run(throw_if_odd(i));
+
+    bool caught = false;
+
+    try
+    {
+        group.wait();
+    }
+    catch (std::runtime_error &)
+    {
+        caught = true;
+    }
+
+    ASSERT_EQUAL(caught, true);
+
+    // the exception has been consumed
+    group.run(throw_if_odd(0));
+    group.wait();
+}
+DECLARE_UNITTEST(TestTaskGroupException);
+
+
+struct count_visits
+{
+    std::atomic<int> *visits;
+
+    count_visits(std::atomic<int> *visits) : visits(visits) {}
+
+    void operator()(size_t i)
+    {
+        ++visits[i];
+    }
+};
+
+void TestParallelForVisitsEachIndexOnce(void)
+{
+    using thrust::detail::device::threads::detail::parallel_for;
+
+    const size_t n = 100003;
+
+    std::vector< std::atomic<int> > visits(n);
+    for (size_t i = 0; i < n; i++)
+        visits[i] = 0;
+
+    parallel_for(n, count_visits(&visits[0]), size_t(7));
+
+    size_t num_errors = 0;
+    for (size_t i = 0; i < n; i++)
+        num_errors += (visits[i] != 1);
+
+    ASSERT_EQUAL(num_errors, 0u);
+}
+DECLARE_UNITTEST(TestParallelForVisitsEachIndexOnce);
+
+#endif // THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+
@@ -1,6 +1,9 @@
 #include <unittest/unittest.h>
 #include <thrust/unique.h>
 #include <thrust/functional.h>
+#include <thrust/workspace.h>
+#include <thrust/device_malloc.h>
+#include <thrust/device_free.h>
 
 template<typename T>
 struct is_equal_div_10_unique
@@ -144,6 +147,38 @@ struct TestUniqueCopy
 VariableUnitTest<TestUniqueCopy, IntegralTypes> TestUniqueCopyInstance;
 
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP && __THRUST_HAS_TEMPORARY_CACHE
+void TestUniqueInPlace(void)
+{
+    const size_t n = 100000;
+
+    thrust::host_vector<int>   h_data = unittest::random_integers<bool>(n);
+    thrust::device_vector<int> d_data = h_data;
+
+    // the OpenMP unique needs no more than a few bytes per thread
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(4096);
+
+    {
+        thrust::scoped_workspace workspace(region, 4096);
+
+        size_t h_size = thrust::unique(h_data.begin(), h_data.end()) - h_data.begin();
+        size_t d_size = thrust::unique(d_data.begin(), d_data.end()) - d_data.begin();
+
+        ASSERT_EQUAL(h_size, d_size);
+        ASSERT_EQUAL(workspace.bytes_in_use(), 0u);
+
+        h_data.resize(h_size);
+        d_data.resize(d_size);
+    }
+
+    ASSERT_EQUAL(h_data, d_data);
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestUniqueInPlace);
+#endif // THRUST_DEVICE_BACKEND_OMP
+
+
 template <typename Vector>
 void initialize_keys(Vector& keys)
 {
@@ -1,6 +1,7 @@
 #include <unittest/unittest.h>
 #include <thrust/sequence.h>
 #include <thrust/device_malloc_allocator.h>
+#include <thrust/experimental/shared_allocator.h>
 #include <vector>
 #include <list>
 #include <limits>
@@ -360,6 +361,94 @@ void TestVectorSwap(void)
 }
 DECLARE_VECTOR_UNITTEST(TestVectorSwap);
 
+template <class Vector>
+void TestVectorAdopt(void)
+{
+    Vector v(3);
+    v[0] = 0; v[1] = 1; v[2] = 2;
+
+    Vector u(5, 13);
+
+    typename Vector::value_type *storage = thrust::raw_pointer_cast(&v[0]);
+
+    u.adopt(v);
+
+    // u holds v's storage and v is empty
+    ASSERT_EQUAL(u.size(), 3);
+    ASSERT_EQUAL(v.size(), 0);
+    ASSERT_EQUAL(v.capacity(), 0);
+    ASSERT_EQUAL(thrust::raw_pointer_cast(&u[0]) == storage, true);
+
+    ASSERT_EQUAL(u[0], 0);
+    ASSERT_EQUAL(u[1], 1);
+    ASSERT_EQUAL(u[2], 2);
+
+    // v remains usable
+    v.push_back(7);
+    ASSERT_EQUAL(v[0], 7);
+}
+DECLARE_VECTOR_UNITTEST(TestVectorAdopt);
+
+#if __THRUST_HAS_RVALUE_REFERENCES
+template <class Vector>
+void TestVectorMove(void)
+{
+    Vector v(3);
+    v[0] = 0; v[1] = 1; v[2] = 2;
+
+    typename Vector::value_type *storage = thrust::raw_pointer_cast(&v[0]);
+
+    Vector u(std::move(v));
+
+    ASSERT_EQUAL(v.size(), 0);
+    ASSERT_EQUAL(u.size(), 3);
+    ASSERT_EQUAL(thrust::raw_pointer_cast(&u[0]) == storage, true);
+
+    Vector w(5, 13);
+    w = std::move(u);
+
+    ASSERT_EQUAL(u.size(), 0);
+    ASSERT_EQUAL(w.size(), 3);
+    ASSERT_EQUAL(thrust::raw_pointer_cast(&w[0]) == storage, true);
+
+    ASSERT_EQUAL(w[0], 0);
+    ASSERT_EQUAL(w[1], 1);
+    ASSERT_EQUAL(w[2], 2);
+}
+DECLARE_VECTOR_UNITTEST(TestVectorMove);
+#endif // __THRUST_HAS_RVALUE_REFERENCES
+
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+void TestVectorAdoptBetweenHostAndDevice(void)
+{
+    typedef thrust::host_vector<int, thrust::experimental::shared_allocator<int> > shared_host_vector;
+
+    shared_host_vector h(1000);
+    thrust::sequence(h.begin(), h.end());
+
+    int *storage = thrust::raw_pointer_cast(&h[0]);
+
+    thrust::device_vector<int> d(10, 13);
+    d.adopt(h);
+
+    ASSERT_EQUAL(h.size(), 0);
+    ASSERT_EQUAL(d.size(), 1000);
+    ASSERT_EQUAL(thrust::raw_pointer_cast(&d[0]) == storage, true);
+    ASSERT_EQUAL(d[999], 999);
+
+    // grow the device_vector, which reallocates with device_malloc
+    d.resize(2000, 42);
+
+    h.adopt(d);
+
+    ASSERT_EQUAL(d.size(), 0);
+    ASSERT_EQUAL(h.size(), 2000);
+    ASSERT_EQUAL(h[999],  999);
+    ASSERT_EQUAL(h[1999], 42);
+}
+DECLARE_UNITTEST(TestVectorAdoptBetweenHostAndDevice);
+#endif // THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+
 
 template <class Vector>
 void TestVectorErasePosition(void)
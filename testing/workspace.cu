@@ -0,0 +1,237 @@
+#include <unittest/unittest.h>
+#include <thrust/workspace.h>
+#include <thrust/sort.h>
+#include <thrust/reduce.h>
+#include <thrust/remove.h>
+#include <thrust/unique.h>
+#include <thrust/segmented_scan.h>
+#include <thrust/device_malloc.h>
+#include <thrust/device_free.h>
+#include <thrust/temporary_cache.h>
+
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA && __THRUST_HAS_TEMPORARY_CACHE
+
+template <typename T>
+struct is_even
+{
+    __host__ __device__
+    bool operator()(T x) const { return (x % 2) == 0; }
+};
+
+// a comparison which the radix sort does not recognize
+template <typename T>
+struct greater_comp
+{
+    __host__ __device__
+    bool operator()(T x, T y) const { return x > y; }
+};
+
+void TestWorkspaceSortByKey(void)
+{
+    const size_t n = 100000;
+
+    thrust::host_vector<int>   h_keys   = unittest::random_integers<int>(n);
+    thrust::host_vector<float> h_values = unittest::random_samples<float>(n);
+
+    thrust::device_vector<int>   d_keys   = h_keys;
+    thrust::device_vector<float> d_values = h_values;
+
+    thrust::stable_sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin());
+
+    const size_t num_bytes = thrust::sort_by_key_workspace_bytes<int,float>(n);
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(num_bytes);
+
+    thrust::temporary_cache::trim();
+
+    {
+        thrust::scoped_workspace workspace(region, num_bytes);
+
+        thrust::stable_sort_by_key(d_keys.begin(), d_keys.end(), d_values.begin());
+
+        ASSERT_EQUAL(workspace.bytes_in_use(), 0u);
+        ASSERT_EQUAL(workspace.high_water_mark(), num_bytes);
+    }
+
+    // nothing was drawn from the cache
+    ASSERT_EQUAL(thrust::temporary_cache::cached_bytes(), 0u);
+
+    ASSERT_EQUAL(h_keys,   d_keys);
+    ASSERT_EQUAL(h_values, d_values);
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestWorkspaceSortByKey);
+
+void TestWorkspaceSortByKeyGeneralComparison(void)
+{
+    const size_t n = 100000;
+
+    thrust::host_vector<int> h_keys   = unittest::random_integers<int>(n);
+    thrust::host_vector<int> h_values = unittest::random_integers<int>(n);
+
+    thrust::device_vector<int> d_keys   = h_keys;
+    thrust::device_vector<int> d_values = h_values;
+
+    thrust::stable_sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin(), greater_comp<int>());
+
+    const size_t num_bytes = thrust::sort_by_key_workspace_bytes<int,int>(n, greater_comp<int>());
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(num_bytes);
+
+    {
+        thrust::scoped_workspace workspace(region, num_bytes);
+
+        thrust::stable_sort_by_key(d_keys.begin(), d_keys.end(), d_values.begin(), greater_comp<int>());
+
+        ASSERT_EQUAL(workspace.high_water_mark(), num_bytes);
+    }
+
+    ASSERT_EQUAL(h_keys,   d_keys);
+    ASSERT_EQUAL(h_values, d_values);
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestWorkspaceSortByKeyGeneralComparison);
+
+void TestWorkspaceReduceByKeyAndUniqueByKey(void)
+{
+    const size_t n = 100000;
+
+    thrust::host_vector<int> h_keys   = unittest::random_integers<bool>(n);
+    thrust::host_vector<int> h_values = unittest::random_integers<int>(n);
+
+    thrust::device_vector<int> d_keys   = h_keys;
+    thrust::device_vector<int> d_values = h_values;
+
+    thrust::host_vector<int>   h_keys_output(n),   h_values_output(n);
+    thrust::device_vector<int> d_keys_output(n),   d_values_output(n);
+
+    size_t h_size = thrust::reduce_by_key(h_keys.begin(), h_keys.end(), h_values.begin(),
+                                          h_keys_output.begin(), h_values_output.begin()).first - h_keys_output.begin();
+
+    const size_t num_bytes = std::max(thrust::reduce_by_key_workspace_bytes<int>(n),
+                                      thrust::unique_by_key_workspace_bytes<int,int>(n));
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(num_bytes);
+
+    {
+        thrust::scoped_workspace workspace(region, num_bytes);
+
+        size_t d_size = thrust::reduce_by_key(d_keys.begin(), d_keys.end(), d_values.begin(),
+                                              d_keys_output.begin(), d_values_output.begin()).first - d_keys_output.begin();
+
+        ASSERT_EQUAL(workspace.high_water_mark(), thrust::reduce_by_key_workspace_bytes<int>(n));
+        ASSERT_EQUAL(h_size, d_size);
+
+        h_size = thrust::unique_by_key(h_keys.begin(), h_keys.end(), h_values.begin()).first - h_keys.begin();
+        d_size = thrust::unique_by_key(d_keys.begin(), d_keys.end(), d_values.begin()).first - d_keys.begin();
+
+        ASSERT_EQUAL(workspace.high_water_mark(), num_bytes);
+        ASSERT_EQUAL(h_size, d_size);
+    }
+
+    ASSERT_EQUAL(h_keys_output,   d_keys_output);
+    ASSERT_EQUAL(h_values_output, d_values_output);
+    ASSERT_EQUAL(h_keys,          d_keys);
+    ASSERT_EQUAL(h_values,        d_values);
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestWorkspaceReduceByKeyAndUniqueByKey);
+
+void TestWorkspaceCopyIfAndSegmentedScan(void)
+{
+    const size_t n = 100000;
+
+    thrust::host_vector<int> h_data  = unittest::random_integers<int>(n);
+    thrust::host_vector<int> h_flags = unittest::random_integers<bool>(n);
+
+    thrust::device_vector<int> d_data  = h_data;
+    thrust::device_vector<int> d_flags = h_flags;
+
+    thrust::host_vector<int>   h_result(n);
+    thrust::device_vector<int> d_result(n);
+
+    const size_t num_bytes = std::max(thrust::copy_if_workspace_bytes(n),
+                                      thrust::experimental::exclusive_segmented_scan_workspace_bytes<int>(n));
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(num_bytes);
+
+    {
+        thrust::scoped_workspace workspace(region, num_bytes);
+
+        size_t h_size = thrust::copy_if(h_data.begin(), h_data.end(), h_result.begin(), is_even<int>()) - h_result.begin();
+        size_t d_size = thrust::copy_if(d_data.begin(), d_data.end(), d_result.begin(), is_even<int>()) - d_result.begin();
+
+        ASSERT_EQUAL(h_size, d_size);
+        ASSERT_EQUAL(h_result, d_result);
+        ASSERT_EQUAL(workspace.high_water_mark(), thrust::copy_if_workspace_bytes(n));
+
+        thrust::experimental::inclusive_segmented_scan(h_data.begin(), h_data.end(), h_flags.begin(), h_result.begin());
+        thrust::experimental::inclusive_segmented_scan(d_data.begin(), d_data.end(), d_flags.begin(), d_result.begin());
+
+        ASSERT_EQUAL(h_result, d_result);
+
+        thrust::experimental::exclusive_segmented_scan(h_data.begin(), h_data.end(), h_flags.begin(), h_result.begin(), 13);
+        thrust::experimental::exclusive_segmented_scan(d_data.begin(), d_data.end(), d_flags.begin(), d_result.begin(), 13);
+
+        ASSERT_EQUAL(h_result, d_result);
+        ASSERT_EQUAL(workspace.high_water_mark(), num_bytes);
+    }
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestWorkspaceCopyIfAndSegmentedScan);
+
+void TestWorkspaceTooSmall(void)
+{
+    const size_t n = 100000;
+
+    thrust::device_vector<int> keys(n, 0);
+    thrust::device_vector<int> values(n, 0);
+
+    const size_t num_bytes = thrust::sort_by_key_workspace_bytes<int,int>(n) / 2;
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(num_bytes);
+
+    {
+        thrust::scoped_workspace workspace(region, num_bytes);
+
+        ASSERT_THROWS(thrust::sort_by_key(keys.begin(), keys.end(), values.begin()), std::bad_alloc);
+
+        // the temporaries of the failed call were released
+        ASSERT_EQUAL(workspace.bytes_in_use(), 0u);
+    }
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestWorkspaceTooSmall);
+
+void TestWorkspaceNested(void)
+{
+    typedef thrust::detail::raw_buffer<int, thrust::device_space_tag> buffer_type;
+
+    thrust::device_ptr<char> region = thrust::device_malloc<char>(4096);
+
+    {
+        thrust::scoped_workspace outer(region, 2048);
+
+        buffer_type a(100);
+
+        ASSERT_EQUAL(outer.bytes_in_use(), 512u);
+
+        {
+            thrust::scoped_workspace inner(region + 2048, 2048);
+
+            buffer_type b(10);
+            ASSERT_EQUAL(inner.bytes_in_use(), 256u);
+            ASSERT_EQUAL(outer.bytes_in_use(), 512u);
+        }
+
+        buffer_type c(10);
+        ASSERT_EQUAL(outer.bytes_in_use(), 768u);
+        ASSERT_EQUAL(thrust::raw_pointer_cast(&*c.begin()) - thrust::raw_pointer_cast(&*a.begin()), 128);
+    }
+
+    thrust::device_free(region);
+}
+DECLARE_UNITTEST(TestWorkspaceNested);
+
+#endif // THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+
@@ -0,0 +1,555 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file async.h
+ *  \brief Defines asynchronous versions of the core algorithms
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_CUDA
+#error The asynchronous algorithms require the OpenMP or threads device backend.
+#endif // THRUST_DEVICE_BACKEND
+
+#if (__cplusplus < 201103L) && (THRUST_HOST_COMPILER != THRUST_HOST_COMPILER_MSVC)
+#error The asynchronous algorithms require C++11 support (e.g. -std=c++11).
+#endif // C++11
+
+#include <thrust/future.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+
+/*! \addtogroup async
+ *  \{
+ */
+
+/*! The algorithms in namespace \p async launch their synchronous counterparts
+ *  on a pool of host threads and return immediately.  Each returns an \p event,
+ *  or a \p future which also carries the algorithm's result.  Each algorithm
+ *  optionally takes an \p event as its first parameter, in which case the
+ *  launch does not begin until that event has completed.  Independent
+ *  operations, e.g. sorting one sequence while reducing another, may thus
+ *  execute concurrently on the OpenMP and std::thread device backends.
+ *
+ *  The caller must keep the ranges an operation accesses alive, and must not
+ *  modify them, until the operation completes.  If an operation throws, the
+ *  exception is rethrown by \p event::wait or \p future::get, and operations
+ *  which depend on it do not execute but complete with the same exception.
+ *
+ *  Each operation runs under the \p thrust::omp::execution_config and
+ *  deterministic mode in effect on the launching thread, whichever thread
+ *  ends up executing it.  On the OpenMP backend, the threads of that
+ *  configuration are divided evenly among the operations queued or executing
+ *  when the operation is queued, so that k operations running at once use
+ *  about as many threads in total as one operation alone.
+ *
+ *  The following code snippet sorts one sequence while reducing another, then
+ *  reduces the sorted sequence once the sort has completed.
+ *
+ *  \code
+ *  #include <thrust/async.h>
+ *  #include <thrust/device_vector.h>
+ *  ...
+ *  thrust::device_vector<int> a(1 << 20), b(1 << 20);
+ *  ...
+ *  thrust::event             sorted = thrust::async::sort(a.begin(), a.end());
+ *  thrust::future<int>       sum_b  = thrust::async::reduce(b.begin(), b.end());
+ *  thrust::future<int>       min_a  = thrust::async::reduce(sorted, a.begin(), a.begin() + 1);
+ *
+ *  int x = sum_b.get() + min_a.get();
+ *  \endcode
+ *
+ *  \note These algorithms require a compiler which supports C++11.
+ */
+namespace async
+{
+
+/*! Asynchronous \p thrust::reduce.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \return A \p future holding the result of the reduction.
+ *
+ *  \see thrust::reduce
+ */
+template<typename InputIterator>
+  thrust::future<typename thrust::iterator_traits<InputIterator>::value_type>
+    reduce(InputIterator first,
+           InputIterator last);
+
+/*! Asynchronous \p thrust::reduce, launched once \p depends_on has completed.
+ *
+ *  \param depends_on The \p event to wait for.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \return A \p future holding the result of the reduction.
+ *
+ *  \see thrust::reduce
+ */
+template<typename InputIterator>
+  thrust::future<typename thrust::iterator_traits<InputIterator>::value_type>
+    reduce(const thrust::event &depends_on,
+           InputIterator first,
+           InputIterator last);
+
+/*! Asynchronous \p thrust::reduce with an initial value.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param init The initial value.
+ *  \return A \p future holding the result of the reduction.
+ *
+ *  \see thrust::reduce
+ */
+template<typename InputIterator,
+         typename T>
+  thrust::future<T>
+    reduce(InputIterator first,
+           InputIterator last,
+           T init);
+
+/*! Asynchronous \p thrust::reduce with an initial value, launched once
+ *  \p depends_on has completed.
+ *
+ *  \see thrust::reduce
+ */
+template<typename InputIterator,
+         typename T>
+  thrust::future<T>
+    reduce(const thrust::event &depends_on,
+           InputIterator first,
+           InputIterator last,
+           T init);
+
+/*! Asynchronous \p thrust::reduce with an initial value and a binary operation.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param init The initial value.
+ *  \param binary_op The binary function used to combine values.
+ *  \return A \p future holding the result of the reduction.
+ *
+ *  \see thrust::reduce
+ */
+template<typename InputIterator,
+         typename T,
+         typename BinaryFunction>
+  thrust::future<T>
+    reduce(InputIterator first,
+           InputIterator last,
+           T init,
+           BinaryFunction binary_op);
+
+/*! Asynchronous \p thrust::reduce with an initial value and a binary operation,
+ *  launched once \p depends_on has completed.
+ *
+ *  \see thrust::reduce
+ */
+template<typename InputIterator,
+         typename T,
+         typename BinaryFunction>
+  thrust::future<T>
+    reduce(const thrust::event &depends_on,
+           InputIterator first,
+           InputIterator last,
+           T init,
+           BinaryFunction binary_op);
+
+/*! Asynchronous \p thrust::transform_reduce.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param unary_op The function applied to each element of the input sequence.
+ *  \param init The initial value.
+ *  \param binary_op The binary function used to combine transformed values.
+ *  \return A \p future holding the result of the reduction.
+ *
+ *  \see thrust::transform_reduce
+ */
+template<typename InputIterator, 
+         typename UnaryFunction, 
+         typename OutputType,
+         typename BinaryFunction>
+  thrust::future<OutputType>
+    transform_reduce(InputIterator first,
+                     InputIterator last,
+                     UnaryFunction unary_op,
+                     OutputType init,
+                     BinaryFunction binary_op);
+
+/*! Asynchronous \p thrust::transform_reduce, launched once \p depends_on has completed.
+ *
+ *  \see thrust::transform_reduce
+ */
+template<typename InputIterator, 
+         typename UnaryFunction, 
+         typename OutputType,
+         typename BinaryFunction>
+  thrust::future<OutputType>
+    transform_reduce(const thrust::event &depends_on,
+                     InputIterator first,
+                     InputIterator last,
+                     UnaryFunction unary_op,
+                     OutputType init,
+                     BinaryFunction binary_op);
+
+/*! Asynchronous \p thrust::for_each.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param f The function to apply to each element.
+ *  \return An \p event which completes with the operation.
+ *
+ *  \see thrust::for_each
+ */
+template<typename InputIterator,
+         typename UnaryFunction>
+  thrust::event
+    for_each(InputIterator first,
+             InputIterator last,
+             UnaryFunction f);
+
+/*! Asynchronous \p thrust::for_each, launched once \p depends_on has completed.
+ *
+ *  \see thrust::for_each
+ */
+template<typename InputIterator,
+         typename UnaryFunction>
+  thrust::event
+    for_each(const thrust::event &depends_on,
+             InputIterator first,
+             InputIterator last,
+             UnaryFunction f);
+
+/*! Asynchronous \p thrust::copy.
+ *
+ *  \param first The beginning of the sequence to copy.
+ *  \param last The end of the sequence to copy.
+ *  \param result The destination sequence.
+ *  \return A \p future holding the end of the destination sequence.
+ *
+ *  \see thrust::copy
+ */
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    copy(InputIterator first,
+         InputIterator last,
+         OutputIterator result);
+
+/*! Asynchronous \p thrust::copy, launched once \p depends_on has completed.
+ *
+ *  \see thrust::copy
+ */
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    copy(const thrust::event &depends_on,
+         InputIterator first,
+         InputIterator last,
+         OutputIterator result);
+
+/*! Asynchronous \p thrust::inclusive_scan using \c operator+.
+ *
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param result The beginning of the output sequence.
+ *  \return A \p future holding the end of the output sequence.
+ *
+ *  \see thrust::inclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    inclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result);
+
+/*! Asynchronous \p thrust::inclusive_scan using \c operator+, launched once
+ *  \p depends_on has completed.
+ *
+ *  \see thrust::inclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    inclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result);
+
+/*! Asynchronous \p thrust::inclusive_scan.
+ *
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param result The beginning of the output sequence.
+ *  \param binary_op The associative operator used to 'sum' values.
+ *  \return A \p future holding the end of the output sequence.
+ *
+ *  \see thrust::inclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator>
+  thrust::future<OutputIterator>
+    inclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   AssociativeOperator binary_op);
+
+/*! Asynchronous \p thrust::inclusive_scan, launched once \p depends_on has completed.
+ *
+ *  \see thrust::inclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator>
+  thrust::future<OutputIterator>
+    inclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   AssociativeOperator binary_op);
+
+/*! Asynchronous \p thrust::exclusive_scan using \c 0 and \c operator+.
+ *
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param result The beginning of the output sequence.
+ *  \return A \p future holding the end of the output sequence.
+ *
+ *  \see thrust::exclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    exclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result);
+
+/*! Asynchronous \p thrust::exclusive_scan using \c 0 and \c operator+,
+ *  launched once \p depends_on has completed.
+ *
+ *  \see thrust::exclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    exclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result);
+
+/*! Asynchronous \p thrust::exclusive_scan using \c operator+.
+ *
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param result The beginning of the output sequence.
+ *  \param init The initial value.
+ *  \return A \p future holding the end of the output sequence.
+ *
+ *  \see thrust::exclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T>
+  thrust::future<OutputIterator>
+    exclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   T init);
+
+/*! Asynchronous \p thrust::exclusive_scan using \c operator+, launched once
+ *  \p depends_on has completed.
+ *
+ *  \see thrust::exclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T>
+  thrust::future<OutputIterator>
+    exclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   T init);
+
+/*! Asynchronous \p thrust::exclusive_scan.
+ *
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param result The beginning of the output sequence.
+ *  \param init The initial value.
+ *  \param binary_op The associative operator used to 'sum' values.
+ *  \return A \p future holding the end of the output sequence.
+ *
+ *  \see thrust::exclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator>
+  thrust::future<OutputIterator>
+    exclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   T init,
+                   AssociativeOperator binary_op);
+
+/*! Asynchronous \p thrust::exclusive_scan, launched once \p depends_on has completed.
+ *
+ *  \see thrust::exclusive_scan
+ */
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator>
+  thrust::future<OutputIterator>
+    exclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   T init,
+                   AssociativeOperator binary_op);
+
+/*! Asynchronous \p thrust::sort using \c operator<.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \return An \p event which completes with the sort.
+ *
+ *  \see thrust::sort
+ */
+template<typename RandomAccessIterator>
+  thrust::event
+    sort(RandomAccessIterator first,
+         RandomAccessIterator last);
+
+/*! Asynchronous \p thrust::sort using \c operator<, launched once
+ *  \p depends_on has completed.
+ *
+ *  \see thrust::sort
+ */
+template<typename RandomAccessIterator>
+  thrust::event
+    sort(const thrust::event &depends_on,
+         RandomAccessIterator first,
+         RandomAccessIterator last);
+
+/*! Asynchronous \p thrust::sort.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param comp Comparison operator.
+ *  \return An \p event which completes with the sort.
+ *
+ *  \see thrust::sort
+ */
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+  thrust::event
+    sort(RandomAccessIterator first,
+         RandomAccessIterator last,
+         StrictWeakOrdering comp);
+
+/*! Asynchronous \p thrust::sort, launched once \p depends_on has completed.
+ *
+ *  \see thrust::sort
+ */
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+  thrust::event
+    sort(const thrust::event &depends_on,
+         RandomAccessIterator first,
+         RandomAccessIterator last,
+         StrictWeakOrdering comp);
+
+/*! Asynchronous \p thrust::sort_by_key using \c operator<.
+ *
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \return An \p event which completes with the sort.
+ *
+ *  \see thrust::sort_by_key
+ */
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator>
+  thrust::event
+    sort_by_key(RandomAccessKeyIterator keys_first,
+                RandomAccessKeyIterator keys_last,
+                RandomAccessValueIterator values_first);
+
+/*! Asynchronous \p thrust::sort_by_key using \c operator<, launched once
+ *  \p depends_on has completed.
+ *
+ *  \see thrust::sort_by_key
+ */
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator>
+  thrust::event
+    sort_by_key(const thrust::event &depends_on,
+                RandomAccessKeyIterator keys_first,
+                RandomAccessKeyIterator keys_last,
+                RandomAccessValueIterator values_first);
+
+/*! Asynchronous \p thrust::sort_by_key.
+ *
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param comp Comparison operator.
+ *  \return An \p event which completes with the sort.
+ *
+ *  \see thrust::sort_by_key
+ */
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator,
+         typename StrictWeakOrdering>
+  thrust::event
+    sort_by_key(RandomAccessKeyIterator keys_first,
+                RandomAccessKeyIterator keys_last,
+                RandomAccessValueIterator values_first,
+                StrictWeakOrdering comp);
+
+/*! Asynchronous \p thrust::sort_by_key, launched once \p depends_on has completed.
+ *
+ *  \see thrust::sort_by_key
+ */
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator,
+         typename StrictWeakOrdering>
+  thrust::event
+    sort_by_key(const thrust::event &depends_on,
+                RandomAccessKeyIterator keys_first,
+                RandomAccessKeyIterator keys_last,
+                RandomAccessValueIterator values_first,
+                StrictWeakOrdering comp);
+
+} // end async
+
+/*! \} // end async
+ */
+
+} // end thrust
+
+#include <thrust/detail/async.inl>
+
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file allocator_shares_storage.h
+ *  \brief Determines whether one allocator may release the storage of another.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+
+namespace thrust
+{
+
+// forward declarations to WAR circular #includes
+template<typename T> class device_malloc_allocator;
+
+namespace experimental
+{
+
+template<typename T> class shared_allocator;
+
+} // end experimental
+
+namespace detail
+{
+
+// whether storage obtained from Alloc1 may be released by Alloc2, so that
+// a vector using Alloc2 may adopt the storage of a vector using Alloc1
+template<typename Alloc1, typename Alloc2>
+  struct allocators_share_storage
+    : is_same<Alloc1,Alloc2>
+{};
+
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+// device_malloc and shared_allocator both allocate with generic::malloc
+template<typename T>
+  struct allocators_share_storage<thrust::device_malloc_allocator<T>, thrust::experimental::shared_allocator<T> >
+    : true_type
+{};
+
+template<typename T>
+  struct allocators_share_storage<thrust::experimental::shared_allocator<T>, thrust::device_malloc_allocator<T> >
+    : true_type
+{};
+#endif // THRUST_DEVICE_BACKEND
+
+} // end detail
+
+} // end thrust
+
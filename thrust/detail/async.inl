@@ -0,0 +1,694 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file async.inl
+ *  \brief Inline file for async.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/future.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/reduce.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/for_each.h>
+#include <thrust/copy.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
+#include <thrust/detail/device/omp/execution_config.h>
+#include <thrust/detail/device/omp/deterministic.h>
+#include <thrust/detail/device/threads/detail/thread_pool.h>
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+namespace thrust
+{
+namespace detail
+{
+namespace async
+{
+
+// the number of threads an operation launched under config may use
+inline int max_threads(const thrust::detail::device::omp::execution_config &config)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  return config.num_threads > 0 ? config.num_threads : omp_get_max_threads();
+#else
+  return config.num_threads > 0 ? config.num_threads : 1;
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end max_threads()
+
+// runs f(*state) on the thread pool after dependency has completed, under
+// the execution configuration and deterministic mode of the launching thread.
+// the threads of that configuration are divided evenly among the operations
+// which are queued or executing when this one is queued, so that operations
+// running at once do not start a full team each
+template<typename State,
+         typename Function>
+  class async_task
+    : public async_task_base
+{
+  public:
+    async_task(const thrust::event &dependency,
+               const Function &f,
+               const std::shared_ptr<State> &state)
+      : m_dependency(dependency), m_f(f), m_state(state),
+        m_config(thrust::detail::device::omp::current_execution_config()),
+        m_max_threads(max_threads(m_config)),
+        m_deterministic(thrust::detail::device::omp::deterministic_reductions())
+    {}
+
+    void execute(void)
+    {
+      thrust::detail::device::omp::execution_config config = m_config;
+      config.num_threads = std::max(1, m_max_threads / m_num_runnable);
+
+      // the task may run on a pool thread or on a thread waiting for it,
+      // so it must not depend on the settings of either
+      thrust::detail::device::omp::scoped_execution_config         scope(config);
+      thrust::detail::device::omp::scoped_deterministic_reductions deterministic(m_deterministic);
+
+      try
+      {
+        // the dependency has completed, but an exception it exited with
+        // propagates to this operation
+        m_dependency.wait();
+
+        m_f(*m_state);
+      }
+      catch(...)
+      {
+        m_state->set_exception(std::current_exception());
+      }
+
+      // operations which depend on this one do not count it
+      finished();
+
+      m_state->set_ready();
+
+      delete this;
+    }
+
+  private:
+    thrust::event                                 m_dependency;
+    Function                                      m_f;
+    std::shared_ptr<State>                        m_state;
+    thrust::detail::device::omp::execution_config m_config;
+    int                                           m_max_threads;
+    bool                                          m_deterministic;
+}; // end async_task
+
+template<typename Function>
+  thrust::event launch(const thrust::event &dependency, const Function &f)
+{
+  std::shared_ptr<async_state> state(new async_state);
+
+  async_state::submit_after(dependency,
+    new async_task<async_state,Function>(dependency, f, state));
+
+  return async_state::make_event(state);
+} // end launch()
+
+template<typename T,
+         typename Function>
+  thrust::future<T> launch_with_result(const thrust::event &dependency, const Function &f)
+{
+  std::shared_ptr< async_value_state<T> > state(new async_value_state<T>);
+
+  async_state::submit_after(dependency,
+    new async_task<async_value_state<T>,Function>(dependency, f, state));
+
+  return async_value_state<T>::make_future(state);
+} // end launch_with_result()
+
+
+template<typename InputIterator,
+         typename T,
+         typename BinaryFunction>
+  struct reduce_functor
+{
+  InputIterator first, last;
+  T init;
+  BinaryFunction binary_op;
+
+  reduce_functor(InputIterator first, InputIterator last, T init, BinaryFunction binary_op)
+    : first(first), last(last), init(init), binary_op(binary_op) {}
+
+  void operator()(async_value_state<T> &state)
+  {
+    state.set_value(thrust::reduce(first, last, init, binary_op));
+  }
+}; // end reduce_functor
+
+template<typename InputIterator,
+         typename UnaryFunction,
+         typename OutputType,
+         typename BinaryFunction>
+  struct transform_reduce_functor
+{
+  InputIterator first, last;
+  UnaryFunction unary_op;
+  OutputType init;
+  BinaryFunction binary_op;
+
+  transform_reduce_functor(InputIterator first, InputIterator last,
+                           UnaryFunction unary_op, OutputType init, BinaryFunction binary_op)
+    : first(first), last(last), unary_op(unary_op), init(init), binary_op(binary_op) {}
+
+  void operator()(async_value_state<OutputType> &state)
+  {
+    state.set_value(thrust::transform_reduce(first, last, unary_op, init, binary_op));
+  }
+}; // end transform_reduce_functor
+
+template<typename InputIterator,
+         typename UnaryFunction>
+  struct for_each_functor
+{
+  InputIterator first, last;
+  UnaryFunction f;
+
+  for_each_functor(InputIterator first, InputIterator last, UnaryFunction f)
+    : first(first), last(last), f(f) {}
+
+  void operator()(async_state &)
+  {
+    thrust::for_each(first, last, f);
+  }
+}; // end for_each_functor
+
+template<typename InputIterator,
+         typename OutputIterator>
+  struct copy_functor
+{
+  InputIterator first, last;
+  OutputIterator result;
+
+  copy_functor(InputIterator first, InputIterator last, OutputIterator result)
+    : first(first), last(last), result(result) {}
+
+  void operator()(async_value_state<OutputIterator> &state)
+  {
+    state.set_value(thrust::copy(first, last, result));
+  }
+}; // end copy_functor
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator>
+  struct inclusive_scan_functor
+{
+  InputIterator first, last;
+  OutputIterator result;
+  AssociativeOperator binary_op;
+
+  inclusive_scan_functor(InputIterator first, InputIterator last,
+                         OutputIterator result, AssociativeOperator binary_op)
+    : first(first), last(last), result(result), binary_op(binary_op) {}
+
+  void operator()(async_value_state<OutputIterator> &state)
+  {
+    state.set_value(thrust::inclusive_scan(first, last, result, binary_op));
+  }
+}; // end inclusive_scan_functor
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator>
+  struct exclusive_scan_functor
+{
+  InputIterator first, last;
+  OutputIterator result;
+  T init;
+  AssociativeOperator binary_op;
+
+  exclusive_scan_functor(InputIterator first, InputIterator last,
+                         OutputIterator result, T init, AssociativeOperator binary_op)
+    : first(first), last(last), result(result), init(init), binary_op(binary_op) {}
+
+  void operator()(async_value_state<OutputIterator> &state)
+  {
+    state.set_value(thrust::exclusive_scan(first, last, result, init, binary_op));
+  }
+}; // end exclusive_scan_functor
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+  struct sort_functor
+{
+  RandomAccessIterator first, last;
+  StrictWeakOrdering comp;
+
+  sort_functor(RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp)
+    : first(first), last(last), comp(comp) {}
+
+  void operator()(async_state &)
+  {
+    thrust::sort(first, last, comp);
+  }
+}; // end sort_functor
+
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator,
+         typename StrictWeakOrdering>
+  struct sort_by_key_functor
+{
+  RandomAccessKeyIterator keys_first, keys_last;
+  RandomAccessValueIterator values_first;
+  StrictWeakOrdering comp;
+
+  sort_by_key_functor(RandomAccessKeyIterator keys_first, RandomAccessKeyIterator keys_last,
+                      RandomAccessValueIterator values_first, StrictWeakOrdering comp)
+    : keys_first(keys_first), keys_last(keys_last), values_first(values_first), comp(comp) {}
+
+  void operator()(async_state &)
+  {
+    thrust::sort_by_key(keys_first, keys_last, values_first, comp);
+  }
+}; // end sort_by_key_functor
+
+} // end async
+} // end detail
+
+
+namespace async
+{
+
+
+///////////////
+// Reduction //
+///////////////
+
+template<typename InputIterator>
+  thrust::future<typename thrust::iterator_traits<InputIterator>::value_type>
+    reduce(InputIterator first,
+           InputIterator last)
+{
+  return thrust::async::reduce(thrust::event(), first, last);
+}
+
+template<typename InputIterator>
+  thrust::future<typename thrust::iterator_traits<InputIterator>::value_type>
+    reduce(const thrust::event &depends_on,
+           InputIterator first,
+           InputIterator last)
+{
+  typedef typename thrust::iterator_traits<InputIterator>::value_type InputType;
+
+  // use InputType(0) as init by default
+  return thrust::async::reduce(depends_on, first, last, InputType(0));
+}
+
+template<typename InputIterator,
+         typename T>
+  thrust::future<T>
+    reduce(InputIterator first,
+           InputIterator last,
+           T init)
+{
+  return thrust::async::reduce(thrust::event(), first, last, init);
+}
+
+template<typename InputIterator,
+         typename T>
+  thrust::future<T>
+    reduce(const thrust::event &depends_on,
+           InputIterator first,
+           InputIterator last,
+           T init)
+{
+  // use plus<T> by default
+  return thrust::async::reduce(depends_on, first, last, init, thrust::plus<T>());
+}
+
+template<typename InputIterator,
+         typename T,
+         typename BinaryFunction>
+  thrust::future<T>
+    reduce(InputIterator first,
+           InputIterator last,
+           T init,
+           BinaryFunction binary_op)
+{
+  return thrust::async::reduce(thrust::event(), first, last, init, binary_op);
+}
+
+template<typename InputIterator,
+         typename T,
+         typename BinaryFunction>
+  thrust::future<T>
+    reduce(const thrust::event &depends_on,
+           InputIterator first,
+           InputIterator last,
+           T init,
+           BinaryFunction binary_op)
+{
+  return thrust::detail::async::launch_with_result<T>(depends_on,
+    thrust::detail::async::reduce_functor<InputIterator,T,BinaryFunction>(first, last, init, binary_op));
+}
+
+template<typename InputIterator, 
+         typename UnaryFunction, 
+         typename OutputType,
+         typename BinaryFunction>
+  thrust::future<OutputType>
+    transform_reduce(InputIterator first,
+                     InputIterator last,
+                     UnaryFunction unary_op,
+                     OutputType init,
+                     BinaryFunction binary_op)
+{
+  return thrust::async::transform_reduce(thrust::event(), first, last, unary_op, init, binary_op);
+}
+
+template<typename InputIterator, 
+         typename UnaryFunction, 
+         typename OutputType,
+         typename BinaryFunction>
+  thrust::future<OutputType>
+    transform_reduce(const thrust::event &depends_on,
+                     InputIterator first,
+                     InputIterator last,
+                     UnaryFunction unary_op,
+                     OutputType init,
+                     BinaryFunction binary_op)
+{
+  return thrust::detail::async::launch_with_result<OutputType>(depends_on,
+    thrust::detail::async::transform_reduce_functor<InputIterator,UnaryFunction,OutputType,BinaryFunction>
+      (first, last, unary_op, init, binary_op));
+}
+
+
+//////////////
+// for_each //
+//////////////
+
+template<typename InputIterator,
+         typename UnaryFunction>
+  thrust::event
+    for_each(InputIterator first,
+             InputIterator last,
+             UnaryFunction f)
+{
+  return thrust::async::for_each(thrust::event(), first, last, f);
+}
+
+template<typename InputIterator,
+         typename UnaryFunction>
+  thrust::event
+    for_each(const thrust::event &depends_on,
+             InputIterator first,
+             InputIterator last,
+             UnaryFunction f)
+{
+  return thrust::detail::async::launch(depends_on,
+    thrust::detail::async::for_each_functor<InputIterator,UnaryFunction>(first, last, f));
+}
+
+
+//////////
+// copy //
+//////////
+
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    copy(InputIterator first,
+         InputIterator last,
+         OutputIterator result)
+{
+  return thrust::async::copy(thrust::event(), first, last, result);
+}
+
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    copy(const thrust::event &depends_on,
+         InputIterator first,
+         InputIterator last,
+         OutputIterator result)
+{
+  return thrust::detail::async::launch_with_result<OutputIterator>(depends_on,
+    thrust::detail::async::copy_functor<InputIterator,OutputIterator>(first, last, result));
+}
+
+
+//////////
+// scan //
+//////////
+
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    inclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result)
+{
+  return thrust::async::inclusive_scan(thrust::event(), first, last, result);
+}
+
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    inclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result)
+{
+  typedef typename thrust::iterator_traits<OutputIterator>::value_type OutputType;
+
+  // assume plus as the associative operator
+  return thrust::async::inclusive_scan(depends_on, first, last, result, thrust::plus<OutputType>());
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator>
+  thrust::future<OutputIterator>
+    inclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   AssociativeOperator binary_op)
+{
+  return thrust::async::inclusive_scan(thrust::event(), first, last, result, binary_op);
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator>
+  thrust::future<OutputIterator>
+    inclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   AssociativeOperator binary_op)
+{
+  return thrust::detail::async::launch_with_result<OutputIterator>(depends_on,
+    thrust::detail::async::inclusive_scan_functor<InputIterator,OutputIterator,AssociativeOperator>
+      (first, last, result, binary_op));
+}
+
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    exclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result)
+{
+  return thrust::async::exclusive_scan(thrust::event(), first, last, result);
+}
+
+template<typename InputIterator,
+         typename OutputIterator>
+  thrust::future<OutputIterator>
+    exclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result)
+{
+  typedef typename thrust::iterator_traits<OutputIterator>::value_type OutputType;
+
+  // assume 0 as the initialization value
+  return thrust::async::exclusive_scan(depends_on, first, last, result, OutputType(0));
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T>
+  thrust::future<OutputIterator>
+    exclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   T init)
+{
+  return thrust::async::exclusive_scan(thrust::event(), first, last, result, init);
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T>
+  thrust::future<OutputIterator>
+    exclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   T init)
+{
+  typedef typename thrust::iterator_traits<OutputIterator>::value_type OutputType;
+
+  // assume plus as the associative operator
+  return thrust::async::exclusive_scan(depends_on, first, last, result, init, thrust::plus<OutputType>());
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator>
+  thrust::future<OutputIterator>
+    exclusive_scan(InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   T init,
+                   AssociativeOperator binary_op)
+{
+  return thrust::async::exclusive_scan(thrust::event(), first, last, result, init, binary_op);
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator>
+  thrust::future<OutputIterator>
+    exclusive_scan(const thrust::event &depends_on,
+                   InputIterator first,
+                   InputIterator last,
+                   OutputIterator result,
+                   T init,
+                   AssociativeOperator binary_op)
+{
+  return thrust::detail::async::launch_with_result<OutputIterator>(depends_on,
+    thrust::detail::async::exclusive_scan_functor<InputIterator,OutputIterator,T,AssociativeOperator>
+      (first, last, result, init, binary_op));
+}
+
+
+//////////
+// sort //
+//////////
+
+template<typename RandomAccessIterator>
+  thrust::event
+    sort(RandomAccessIterator first,
+         RandomAccessIterator last)
+{
+  return thrust::async::sort(thrust::event(), first, last);
+}
+
+template<typename RandomAccessIterator>
+  thrust::event
+    sort(const thrust::event &depends_on,
+         RandomAccessIterator first,
+         RandomAccessIterator last)
+{
+  typedef typename thrust::iterator_traits<RandomAccessIterator>::value_type KeyType;
+
+  return thrust::async::sort(depends_on, first, last, thrust::less<KeyType>());
+}
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+  thrust::event
+    sort(RandomAccessIterator first,
+         RandomAccessIterator last,
+         StrictWeakOrdering comp)
+{
+  return thrust::async::sort(thrust::event(), first, last, comp);
+}
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+  thrust::event
+    sort(const thrust::event &depends_on,
+         RandomAccessIterator first,
+         RandomAccessIterator last,
+         StrictWeakOrdering comp)
+{
+  return thrust::detail::async::launch(depends_on,
+    thrust::detail::async::sort_functor<RandomAccessIterator,StrictWeakOrdering>(first, last, comp));
+}
+
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator>
+  thrust::event
+    sort_by_key(RandomAccessKeyIterator keys_first,
+                RandomAccessKeyIterator keys_last,
+                RandomAccessValueIterator values_first)
+{
+  return thrust::async::sort_by_key(thrust::event(), keys_first, keys_last, values_first);
+}
+
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator>
+  thrust::event
+    sort_by_key(const thrust::event &depends_on,
+                RandomAccessKeyIterator keys_first,
+                RandomAccessKeyIterator keys_last,
+                RandomAccessValueIterator values_first)
+{
+  typedef typename thrust::iterator_traits<RandomAccessKeyIterator>::value_type KeyType;
+
+  return thrust::async::sort_by_key(depends_on, keys_first, keys_last, values_first, thrust::less<KeyType>());
+}
+
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator,
+         typename StrictWeakOrdering>
+  thrust::event
+    sort_by_key(RandomAccessKeyIterator keys_first,
+                RandomAccessKeyIterator keys_last,
+                RandomAccessValueIterator values_first,
+                StrictWeakOrdering comp)
+{
+  return thrust::async::sort_by_key(thrust::event(), keys_first, keys_last, values_first, comp);
+}
+
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator,
+         typename StrictWeakOrdering>
+  thrust::event
+    sort_by_key(const thrust::event &depends_on,
+                RandomAccessKeyIterator keys_first,
+                RandomAccessKeyIterator keys_last,
+                RandomAccessValueIterator values_first,
+                StrictWeakOrdering comp)
+{
+  return thrust::detail::async::launch(depends_on,
+    thrust::detail::async::sort_by_key_functor<RandomAccessKeyIterator,RandomAccessValueIterator,StrictWeakOrdering>
+      (keys_first, keys_last, values_first, comp));
+}
+
+} // end async
+
+} // end thrust
+
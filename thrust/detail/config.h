@@ -44,6 +44,7 @@
 // XXX reserve 0 for undefined
 #define THRUST_DEVICE_BACKEND_CUDA    1
 #define THRUST_DEVICE_BACKEND_OMP     2
+#define THRUST_DEVICE_BACKEND_THREADS 3
 
 #ifndef THRUST_DEVICE_BACKEND
 #define THRUST_DEVICE_BACKEND THRUST_DEVICE_BACKEND_CUDA
@@ -91,6 +92,13 @@
 #define THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE THRUST_FALSE
 #endif // _OPENMP
 
+// does the host compiler support rvalue references (i.e., move semantics)?
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define __THRUST_HAS_RVALUE_REFERENCES 1
+#else
+#define __THRUST_HAS_RVALUE_REFERENCES 0
+#endif // rvalue references
+
 #if defined(__DEVICE_EMULATION__)
 #if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
 #pragma message("-----------------------------------------------------------------------")
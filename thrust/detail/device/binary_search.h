@@ -21,7 +21,9 @@
 
 #pragma once
 
+#include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/generic/binary_search.h>
+#include <thrust/detail/device/dispatch/binary_search.h>
 
 namespace thrust
 {
@@ -67,7 +69,9 @@ OutputIterator lower_bound(ForwardIterator begin,
                            OutputIterator output,
                            StrictWeakOrdering comp)
 {
-    return thrust::detail::device::generic::lower_bound(begin, end, values_begin, values_end, output, comp);
+    // dispatch on the space of the searched range
+    return thrust::detail::device::dispatch::lower_bound(begin, end, values_begin, values_end, output, comp,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
@@ -78,7 +82,9 @@ OutputIterator upper_bound(ForwardIterator begin,
                            OutputIterator output,
                            StrictWeakOrdering comp)
 {
-    return thrust::detail::device::generic::upper_bound(begin, end, values_begin, values_end, output, comp);
+    // dispatch on the space of the searched range
+    return thrust::detail::device::dispatch::upper_bound(begin, end, values_begin, values_end, output, comp,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
@@ -89,7 +95,9 @@ OutputIterator binary_search(ForwardIterator begin,
                              OutputIterator output,
                              StrictWeakOrdering comp)
 {
-    return thrust::detail::device::generic::binary_search(begin, end, values_begin, values_end, output, comp);
+    // dispatch on the space of the searched range
+    return thrust::detail::device::dispatch::binary_search(begin, end, values_begin, values_end, output, comp,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 } // end namespace device
@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/device_ptr.h>
+#include <thrust/device_reference.h>
+#include <thrust/detail/device/temporary_cache.h>
+#include <thrust/detail/device/workspace.h>
+#include <limits>
+#include <stdexcept>
+
+#if __THRUST_HAS_TEMPORARY_CACHE
+
+namespace thrust
+{
+
+namespace detail
+{
+
+namespace device
+{
+
+// caching_allocator is an internal_allocator whose storage is recycled
+// through the temporary_cache instead of being returned to the device.
+// While a workspace is installed on the calling thread, storage is carved
+// from the workspace instead.
+template<typename T>
+  class caching_allocator
+{
+  public:
+    typedef T                                 value_type;
+    typedef device_ptr<T>                     pointer;
+    typedef device_ptr<const T>               const_pointer;
+    typedef device_reference<T>               reference;
+    typedef device_reference<const T>         const_reference;
+    typedef std::size_t                       size_type;
+    typedef typename pointer::difference_type difference_type;
+
+    // convert a caching_allocator<T> to caching_allocator<U>
+    template<typename U>
+      struct rebind
+    {
+      typedef caching_allocator<U> other;
+    }; // end rebind
+
+    inline caching_allocator() {}
+
+    inline ~caching_allocator() {}
+
+    inline caching_allocator(caching_allocator const&) {}
+
+    template<typename U>
+    inline caching_allocator(caching_allocator<U> const&) {}
+
+    // address
+    inline pointer address(reference r) { return &r; }
+    
+    inline const_pointer address(const_reference r) { return &r; }
+
+    // memory allocation
+    inline pointer allocate(size_type cnt,
+                            const_pointer = const_pointer(static_cast<T*>(0)))
+    {
+      if(cnt > this->max_size())
+      {
+        throw std::bad_alloc();
+      } // end if
+
+      void *result = 0;
+
+      if(workspace *w = workspace::current())
+        result = w->allocate(cnt * sizeof(T)).get();
+      else
+        result = temporary_cache::instance().allocate(cnt * sizeof(T)).get();
+
+      return pointer(static_cast<T*>(result));
+    } // end allocate()
+
+    inline void deallocate(pointer p, size_type cnt) throw()
+    {
+      void *ptr = p.get();
+
+      if(workspace *w = workspace::owner(thrust::device_ptr<void>(ptr)))
+        w->deallocate(thrust::device_ptr<void>(ptr), cnt * sizeof(T));
+      else
+        temporary_cache::instance().deallocate(thrust::device_ptr<void>(ptr), cnt * sizeof(T));
+    } // end deallocate()
+
+    inline size_type max_size() const
+    {
+      return std::numeric_limits<size_type>::max() / sizeof(T);
+    } // end max_size()
+
+    inline bool operator==(caching_allocator const&) { return true; }
+
+    inline bool operator!=(caching_allocator const &a) {return !operator==(a); }
+}; // end caching_allocator
+
+} // end namespace device
+
+} // end namespace detail
+
+} // end thrust
+
+#endif // __THRUST_HAS_TEMPORARY_CACHE
+
@@ -19,7 +19,7 @@
 
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/dispatch/copy.h>
-#include <thrust/detail/device/generic/copy_if.h>
+#include <thrust/detail/device/dispatch/copy_if.h>
 
 namespace thrust
 {
@@ -50,7 +50,9 @@ template<typename InputIterator1,
                          OutputIterator result,
                          Predicate pred)
 {
-  return thrust::detail::device::generic::copy_if(first, last, stencil, result, pred);
+  // dispatch on the space of the output
+  return thrust::detail::device::dispatch::copy_if(first, last, stencil, result, pred,
+    typename thrust::iterator_space<OutputIterator>::type());
 }
 
 } // end namespace device
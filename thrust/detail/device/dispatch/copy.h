@@ -20,6 +20,10 @@
 #include <thrust/detail/device/omp/copy.h>
 #include <thrust/detail/device/cuda/copy.h>
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+#include <thrust/detail/device/threads/copy.h>
+#endif // THRUST_DEVICE_BACKEND
+
 namespace thrust
 {
 namespace detail
@@ -30,7 +34,7 @@ namespace dispatch
 {
 
 
-// omp path
+// omp or threads path
 // XXX this dispatch process is pretty lousy,
 //     but we can't implement copy(host,omp) & copy(omp,host)
 //     with generic::copy
@@ -41,7 +45,11 @@ template<typename InputIterator,
                       OutputIterator result,
                       thrust::detail::false_type) // neither space is CUDA
 {
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+  return thrust::detail::device::threads::copy(first, last, result);
+#else
   return thrust::detail::device::omp::copy(first, last, result);
+#endif // THRUST_DEVICE_BACKEND
 } // end copy()
 
 
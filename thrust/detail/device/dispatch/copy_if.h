@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/generic/copy_if.h>
+#include <thrust/detail/device/omp/copy_if.h>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+namespace device
+{
+
+namespace dispatch
+{
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Predicate,
+         typename Space>
+  OutputIterator copy_if(InputIterator1 first,
+                         InputIterator1 last,
+                         InputIterator2 stencil,
+                         OutputIterator result,
+                         Predicate pred,
+                         Space)
+{
+  // generic backend
+  return thrust::detail::device::generic::copy_if(first, last, stencil, result, pred);
+} // end copy_if()
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Predicate>
+  OutputIterator copy_if(InputIterator1 first,
+                         InputIterator1 last,
+                         InputIterator2 stencil,
+                         OutputIterator result,
+                         Predicate pred,
+                         thrust::detail::omp_device_space_tag)
+{
+  // refinement for the OpenMP backend
+  return thrust::detail::device::omp::copy_if(first, last, stencil, result, pred);
+} // end copy_if()
+
+
+} // end dispatch
+
+} // end device
+
+} // end detail
+
+} // end thrust
+
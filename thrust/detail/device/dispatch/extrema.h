@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/pair.h>
+#include <thrust/detail/device/generic/extrema.h>
+#include <thrust/detail/device/omp/extrema.h>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+namespace device
+{
+
+namespace dispatch
+{
+
+template <typename ForwardIterator, typename BinaryPredicate, typename Space>
+ForwardIterator min_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp,
+                            Space)
+{
+  // generic backend
+  return thrust::detail::device::generic::min_element(first, last, comp);
+} // end min_element()
+
+
+template <typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator min_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp,
+                            thrust::detail::omp_device_space_tag)
+{
+  // refinement for the OpenMP backend
+  return thrust::detail::device::omp::min_element(first, last, comp);
+} // end min_element()
+
+
+template <typename ForwardIterator, typename BinaryPredicate, typename Space>
+ForwardIterator max_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp,
+                            Space)
+{
+  // generic backend
+  return thrust::detail::device::generic::max_element(first, last, comp);
+} // end max_element()
+
+
+template <typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator max_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp,
+                            thrust::detail::omp_device_space_tag)
+{
+  // refinement for the OpenMP backend
+  return thrust::detail::device::omp::max_element(first, last, comp);
+} // end max_element()
+
+
+template <typename ForwardIterator, typename BinaryPredicate, typename Space>
+thrust::pair<ForwardIterator,ForwardIterator> minmax_element(ForwardIterator first,
+                                                             ForwardIterator last,
+                                                             BinaryPredicate comp,
+                                                             Space)
+{
+  // generic backend
+  return thrust::detail::device::generic::minmax_element(first, last, comp);
+} // end minmax_element()
+
+
+template <typename ForwardIterator, typename BinaryPredicate>
+thrust::pair<ForwardIterator,ForwardIterator> minmax_element(ForwardIterator first,
+                                                             ForwardIterator last,
+                                                             BinaryPredicate comp,
+                                                             thrust::detail::omp_device_space_tag)
+{
+  // refinement for the OpenMP backend
+  return thrust::detail::device::omp::minmax_element(first, last, comp);
+} // end minmax_element()
+
+
+} // end dispatch
+
+} // end device
+
+} // end detail
+
+} // end thrust
+
@@ -0,0 +1,65 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file first_touch.h
+ *  \brief Dispatch layer for first_touch.
+ */
+
+#pragma once
+
+#include <thrust/detail/device/omp/first_touch.h>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+namespace device
+{
+
+namespace dispatch
+{
+
+template<typename RandomAccessIterator,
+         typename Size,
+         typename Space>
+  void first_touch(RandomAccessIterator first,
+                   Size n,
+                   Space)
+{
+  // other backends do not control the placement of their storage
+  ;
+}
+
+template<typename RandomAccessIterator,
+         typename Size>
+  void first_touch(RandomAccessIterator first,
+                   Size n,
+                   thrust::detail::omp_device_space_tag)
+{
+  thrust::detail::device::omp::first_touch(first, n);
+}
+
+} // end dispatch
+
+} // end device
+
+} // end detail
+
+} // end thrust
+
@@ -20,6 +20,10 @@
 #include <thrust/detail/device/cuda/for_each.h>
 #include <thrust/detail/device/omp/for_each.h>
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+#include <thrust/detail/device/threads/for_each.h>
+#endif // THRUST_DEVICE_BACKEND
+
 namespace thrust
 {
 
@@ -52,6 +56,18 @@ template<typename InputIterator,
   thrust::detail::device::cuda::for_each(first, last, f);
 }
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+template<typename InputIterator,
+         typename UnaryFunction>
+  void for_each(InputIterator first,
+                InputIterator last,
+                UnaryFunction f,
+                thrust::detail::threads_device_space_tag)
+{
+  thrust::detail::device::threads::for_each(first, last, f);
+}
+#endif // THRUST_DEVICE_BACKEND
+
 } // end dispatch
 
 } // end device
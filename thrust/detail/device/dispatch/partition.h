@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+#pragma once
+
+#include <thrust/detail/device/generic/partition.h>
+#include <thrust/detail/device/omp/partition.h>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+namespace device
+{
+
+namespace dispatch
+{
+
+template<typename ForwardIterator,
+         typename Predicate,
+         typename Space>
+  ForwardIterator stable_partition(ForwardIterator first,
+                                   ForwardIterator last,
+                                   Predicate pred,
+                                   Space)
+{
+  // generic backend
+  return thrust::detail::device::generic::stable_partition(first, last, pred);
+} // end stable_partition()
+
+
+template<typename ForwardIterator,
+         typename Predicate>
+  ForwardIterator stable_partition(ForwardIterator first,
+                                   ForwardIterator last,
+                                   Predicate pred,
+                                   thrust::detail::omp_device_space_tag)
+{
+  // refinement for the OpenMP backend
+  return thrust::detail::device::omp::stable_partition(first, last, pred);
+} // end stable_partition()
+
+
+} // end dispatch
+
+} // end device
+
+} // end detail
+
+} // end thrust
+
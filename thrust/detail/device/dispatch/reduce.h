@@ -23,6 +23,10 @@
 #include <thrust/detail/device/cuda/reduce.h>
 #include <thrust/detail/device/omp/reduce.h>
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+#include <thrust/detail/device/threads/reduce.h>
+#endif // THRUST_DEVICE_BACKEND
+
 namespace thrust
 {
 namespace detail
@@ -58,6 +62,21 @@ template<typename InputIterator,
     return thrust::detail::device::cuda::reduce(first, last, init, binary_op);
 }
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+template<typename InputIterator, 
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType reduce(InputIterator first,
+                    InputIterator last,
+                    OutputType init,
+                    BinaryFunction binary_op,
+                    thrust::detail::threads_device_space_tag)
+{
+    // std::thread implementation
+    return thrust::detail::device::threads::reduce(first, last, init, binary_op);
+}
+#endif // THRUST_DEVICE_BACKEND
+
 template<typename InputIterator, 
          typename OutputType,
          typename BinaryFunction>
@@ -21,6 +21,10 @@
 #include <thrust/detail/device/cuda/scan.h>
 #include <thrust/detail/device/omp/scan.h>
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+#include <thrust/detail/device/threads/scan.h>
+#endif // THRUST_DEVICE_BACKEND
+
 namespace thrust
 {
 namespace detail
@@ -63,6 +67,41 @@ template<typename InputIterator,
 }
 
 
+/////////////////////////////////
+// std::thread implementations //
+/////////////////////////////////
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+template<typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator>
+  OutputIterator inclusive_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                AssociativeOperator binary_op,
+                                thrust::detail::threads_device_space_tag,
+                                thrust::detail::threads_device_space_tag)
+{
+    return thrust::detail::device::threads::inclusive_scan(first, last, result, binary_op);
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator>
+  OutputIterator exclusive_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                T init,
+                                AssociativeOperator binary_op,
+                                thrust::detail::threads_device_space_tag,
+                                thrust::detail::threads_device_space_tag)
+{
+    return thrust::detail::device::threads::exclusive_scan(first, last, result, init, binary_op);
+}
+#endif // THRUST_DEVICE_BACKEND
+
+
 //////////////////////////
 // CUDA implementations //
 //////////////////////////
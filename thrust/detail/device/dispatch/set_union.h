@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/generic/set_union.h>
+#include <thrust/detail/device/omp/set_union.h>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+namespace device
+{
+
+namespace dispatch
+{
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename Space1,
+         typename Space2,
+         typename Space3>
+  OutputIterator set_union(InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           InputIterator2 last2,
+                           OutputIterator result,
+                           StrictWeakOrdering comp,
+                           Space1,
+                           Space2,
+                           Space3)
+{
+  // generic backend
+  return thrust::detail::device::generic::set_union(first1,last1,first2,last2,result,comp);
+} // end set_union()
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_union(InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           InputIterator2 last2,
+                           OutputIterator result,
+                           StrictWeakOrdering comp,
+                           thrust::detail::omp_device_space_tag,
+                           thrust::detail::omp_device_space_tag,
+                           thrust::detail::omp_device_space_tag)
+{
+  // refinement for the OpenMP backend
+  return thrust::detail::device::omp::set_union(first1,last1,first2,last2,result,comp);
+} // end set_union()
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering,
+         typename Space1,
+         typename Space2,
+         typename Space3,
+         typename Space4,
+         typename Space5,
+         typename Space6>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_union_by_key(InputIterator1 keys_first1,
+                     InputIterator1 keys_last1,
+                     InputIterator2 keys_first2,
+                     InputIterator2 keys_last2,
+                     InputIterator3 values_first1,
+                     InputIterator4 values_first2,
+                     OutputIterator1 keys_result,
+                     OutputIterator2 values_result,
+                     StrictWeakOrdering comp,
+                     Space1,
+                     Space2,
+                     Space3,
+                     Space4,
+                     Space5,
+                     Space6)
+{
+  // generic backend
+  return thrust::detail::device::generic::set_union_by_key(keys_first1,keys_last1,keys_first2,keys_last2,values_first1,values_first2,keys_result,values_result,comp);
+} // end set_union_by_key()
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_union_by_key(InputIterator1 keys_first1,
+                     InputIterator1 keys_last1,
+                     InputIterator2 keys_first2,
+                     InputIterator2 keys_last2,
+                     InputIterator3 values_first1,
+                     InputIterator4 values_first2,
+                     OutputIterator1 keys_result,
+                     OutputIterator2 values_result,
+                     StrictWeakOrdering comp,
+                     thrust::detail::omp_device_space_tag,
+                     thrust::detail::omp_device_space_tag,
+                     thrust::detail::omp_device_space_tag,
+                     thrust::detail::omp_device_space_tag,
+                     thrust::detail::omp_device_space_tag,
+                     thrust::detail::omp_device_space_tag)
+{
+  // refinement for the OpenMP backend
+  return thrust::detail::device::omp::set_union_by_key(keys_first1,keys_last1,keys_first2,keys_last2,values_first1,values_first2,keys_result,values_result,comp);
+} // end set_union_by_key()
+
+} // end dispatch
+
+} // end device
+
+} // end detail
+
+} // end thrust
+
@@ -23,6 +23,10 @@
 #include <thrust/detail/device/cuda/sort.h>
 #include <thrust/detail/device/omp/sort.h>
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+#include <thrust/detail/device/threads/sort.h>
+#endif // THRUST_DEVICE_BACKEND
+
 namespace thrust
 {
 namespace detail
@@ -82,6 +86,33 @@ template<typename RandomAccessKeyIterator,
     thrust::detail::device::cuda::stable_sort_by_key(keys_first, keys_last, values_first, comp);
 }
 
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+  void stable_sort(RandomAccessIterator first,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp,
+                   thrust::detail::threads_device_space_tag)
+{
+    // std::thread implementation
+    thrust::detail::device::threads::stable_sort(first, last, comp);
+}
+
+template<typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(RandomAccessKeyIterator keys_first,
+                          RandomAccessKeyIterator keys_last,
+                          RandomAccessValueIterator values_first,
+                          StrictWeakOrdering comp,
+                          thrust::detail::threads_device_space_tag,
+                          thrust::detail::threads_device_space_tag)
+{
+    // std::thread implementation
+    thrust::detail::device::threads::stable_sort_by_key(keys_first, keys_last, values_first, comp);
+}
+#endif // THRUST_DEVICE_BACKEND
+
 } // end namespace dispatch
 } // end namespace device
 } // end namespace detail
@@ -22,7 +22,8 @@
 #pragma once
 
 #include <thrust/pair.h>
-#include <thrust/detail/device/generic/extrema.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/dispatch/extrema.h>
 
 namespace thrust
 {
@@ -36,7 +37,8 @@ ForwardIterator min_element(ForwardIterator first,
                             ForwardIterator last,
                             BinaryPredicate comp)
 {
-    return thrust::detail::device::generic::min_element(first, last, comp);
+    return thrust::detail::device::dispatch::min_element(first, last, comp,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template <typename ForwardIterator, typename BinaryPredicate>
@@ -44,7 +46,8 @@ ForwardIterator max_element(ForwardIterator first,
                             ForwardIterator last,
                             BinaryPredicate comp)
 {
-    return thrust::detail::device::generic::max_element(first, last, comp);
+    return thrust::detail::device::dispatch::max_element(first, last, comp,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template <typename ForwardIterator, typename BinaryPredicate>
@@ -52,7 +55,8 @@ thrust::pair<ForwardIterator,ForwardIterator> minmax_element(ForwardIterator fir
                                                              ForwardIterator last,
                                                              BinaryPredicate comp)
 {
-    return thrust::detail::device::generic::minmax_element(first, last, comp);
+    return thrust::detail::device::dispatch::minmax_element(first, last, comp,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 } // end namespace device
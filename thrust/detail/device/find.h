@@ -21,7 +21,8 @@
 
 #pragma once
 
-#include <thrust/detail/device/generic/find.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/dispatch/find.h>
 
 namespace thrust
 {
@@ -35,7 +36,9 @@ InputIterator find_if(InputIterator first,
                       InputIterator last,
                       Predicate pred)
 {
-    return thrust::detail::device::generic::find_if(first, last, pred);
+    // dispatch on the space of the input
+    return thrust::detail::device::dispatch::find_if(first, last, pred,
+        typename thrust::iterator_space<InputIterator>::type());
 }
 
 } // end namespace device
@@ -143,7 +143,7 @@ struct lbf
         __host__ __device__
         typename thrust::iterator_traits<RandomAccessIterator>::difference_type
      operator()(RandomAccessIterator begin, RandomAccessIterator end, const T& value, StrictWeakOrdering comp){
-         return __lower_bound(begin, end, value, comp) - begin;
+         return detail::__lower_bound(begin, end, value, comp) - begin;
      }
 };
 
@@ -153,7 +153,7 @@ struct ubf
         __host__ __device__
         typename thrust::iterator_traits<RandomAccessIterator>::difference_type
      operator()(RandomAccessIterator begin, RandomAccessIterator end, const T& value, StrictWeakOrdering comp){
-         return __upper_bound(begin, end, value, comp) - begin;
+         return detail::__upper_bound(begin, end, value, comp) - begin;
      }
 };
 
@@ -162,7 +162,7 @@ struct bsf
     template <class RandomAccessIterator, class T, class StrictWeakOrdering>
         __host__ __device__
      bool operator()(RandomAccessIterator begin, RandomAccessIterator end, const T& value, StrictWeakOrdering comp){
-         RandomAccessIterator iter = __lower_bound(begin, end, value, comp);
+         RandomAccessIterator iter = detail::__lower_bound(begin, end, value, comp);
          return iter != end && !comp(value, thrust::detail::device::dereference(iter));
      }
 };
@@ -213,7 +213,8 @@ OutputType binary_search(ForwardIterator begin,
                          ForwardIterator end,
                          const T& value, 
                          StrictWeakOrdering comp,
-                         BinarySearchFunction func)
+                         BinarySearchFunction func,
+                         thrust::detail::false_type)
 {
     typedef typename thrust::iterator_space<ForwardIterator>::type Space;
 
@@ -232,6 +233,36 @@ OutputType binary_search(ForwardIterator begin,
     // copy result to host and return
     return d_output[0];
 }
+
+template <class OutputType, class ForwardIterator, class T, class StrictWeakOrdering, class BinarySearchFunction>
+OutputType binary_search(ForwardIterator begin,
+                         ForwardIterator end,
+                         const T& value, 
+                         StrictWeakOrdering comp,
+                         BinarySearchFunction func,
+                         thrust::detail::true_type)
+{
+    // the host can address the device's memory, so search from the calling thread
+    return func(begin, end, value, comp);
+}
+
+template <class OutputType, class ForwardIterator, class T, class StrictWeakOrdering, class BinarySearchFunction>
+OutputType binary_search(ForwardIterator begin,
+                         ForwardIterator end,
+                         const T& value, 
+                         StrictWeakOrdering comp,
+                         BinarySearchFunction func)
+{
+    typedef typename thrust::iterator_space<ForwardIterator>::type Space;
+
+    // test for interoperability with host_space
+    typedef typename thrust::detail::are_spaces_interoperable<
+      Space,
+      thrust::host_space_tag
+    >::type interop;
+
+    return detail::binary_search<OutputType>(begin, end, value, comp, func, interop());
+}
    
 } // end namespace detail
 
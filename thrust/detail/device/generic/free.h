@@ -20,10 +20,15 @@
 
 #pragma once
 
+#include <thrust/detail/config.h>
 #include <thrust/device_ptr.h>
 #include <cstdlib>
 #include <iostream>
 
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+#include <malloc.h>
+#endif // THRUST_HOST_COMPILER
+
 namespace thrust
 {
 
@@ -39,7 +44,12 @@ namespace generic
 template<unsigned int DummyParameterToAvoidInstantiation>
 void free(thrust::device_ptr<void> ptr)
 {
+  // blocks come from generic::malloc, which aligns them
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+  return _aligned_free(ptr.get());
+#else
   return std::free(ptr.get());
+#endif // THRUST_HOST_COMPILER
 } // end free()
 
 } // end namespace generic
@@ -21,10 +21,27 @@
 
 #pragma once
 
+#include <thrust/detail/config.h>
 #include <thrust/device_ptr.h>
 #include <cstdlib>
 #include <stdexcept>
 
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif // THRUST_HOST_COMPILER
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif // __linux__
+
+// the alignment, in bytes, of every block returned by generic::malloc.
+// it must be a power of two and a multiple of sizeof(void*)
+#ifndef THRUST_DEVICE_MALLOC_ALIGNMENT
+#define THRUST_DEVICE_MALLOC_ALIGNMENT 64
+#endif // THRUST_DEVICE_MALLOC_ALIGNMENT
+
 namespace thrust
 {
 
@@ -37,10 +54,90 @@ namespace device
 namespace generic
 {
 
+// every block returned by malloc begins at a multiple of malloc_alignment,
+// so kernels may use aligned vector loads and stores from the beginning
+// of a device_vector's storage
+const std::size_t malloc_alignment = THRUST_DEVICE_MALLOC_ALIGNMENT;
+
+// blocks at least huge_page_threshold() bytes large are aligned to and
+// padded to a multiple of huge_page_size, and are backed by transparent
+// huge pages where the system supports them
+const std::size_t huge_page_size = std::size_t(2) << 20;
+
+namespace detail
+{
+
+inline std::size_t default_huge_page_threshold(void)
+{
+  // the threshold may be given in megabytes through the environment;
+  // zero disables huge pages
+  if(const char *env = std::getenv("THRUST_HUGE_PAGE_THRESHOLD_MB"))
+  {
+    long megabytes = std::atol(env);
+
+    return megabytes > 0 ? static_cast<std::size_t>(megabytes) << 20 : 0;
+  } // end if
+
+  return std::size_t(32) << 20;
+} // end default_huge_page_threshold()
+
+inline void *aligned_malloc(std::size_t alignment, std::size_t n)
+{
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+  return _aligned_malloc(n, alignment);
+#else
+  void *result = 0;
+
+  if(posix_memalign(&result, alignment, n) != 0)
+  {
+    return 0;
+  } // end if
+
+  return result;
+#endif // THRUST_HOST_COMPILER
+} // end aligned_malloc()
+
+inline void advise_huge_pages(void *ptr, std::size_t n)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // this is only a hint, so failure is harmless
+  madvise(ptr, n, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+} // end advise_huge_pages()
+
+} // end detail
+
+template<unsigned int DummyParameterToAvoidInstantiation>
+std::size_t huge_page_threshold(void)
+{
+  static const std::size_t result = detail::default_huge_page_threshold();
+  return result;
+} // end huge_page_threshold()
+
 template<unsigned int DummyParameterToAvoidInstantiation>
 thrust::device_ptr<void> malloc(const std::size_t n)
 {
-  void *result = std::malloc(n);
+  const std::size_t threshold = huge_page_threshold<0>();
+
+  void *result = 0;
+
+  if(threshold > 0 && n >= threshold)
+  {
+    // pad to whole huge pages, so that no other allocation shares them
+    const std::size_t padded_n = (n + huge_page_size - 1) / huge_page_size * huge_page_size;
+
+    result = detail::aligned_malloc(huge_page_size, padded_n);
+
+    if(result)
+    {
+      detail::advise_huge_pages(result, padded_n);
+    } // end if
+  } // end if
+  else
+  {
+    // request at least one byte, so that success is distinguishable from failure
+    result = detail::aligned_malloc(malloc_alignment, n > 0 ? n : 1);
+  } // end else
 
   if(!result)
   {
@@ -22,6 +22,8 @@
 #pragma once
 
 #include <algorithm>
+#include <thrust/pair.h>
+#include <thrust/detail/host/detail/set_operation.h>
 
 namespace thrust
 {
@@ -49,6 +51,28 @@ template<typename InputIterator1,
   return std::set_intersection(first1,last1,first2,last2,result,comp);
 } // end set_intersection()
 
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_intersection_by_key(InputIterator1 keys_first1,
+                            InputIterator1 keys_last1,
+                            InputIterator2 keys_first2,
+                            InputIterator2 keys_last2,
+                            InputIterator3 values_first1,
+                            InputIterator4 values_first2,
+                            OutputIterator1 keys_result,
+                            OutputIterator2 values_result,
+                            StrictWeakOrdering comp)
+{
+  return thrust::detail::host::detail::set_operation_by_key<thrust::detail::host::detail::set_intersection_policy>
+    (keys_first1, keys_last1, keys_first2, keys_last2, values_first1, values_first2, keys_result, values_result, comp);
+} // end set_intersection_by_key()
+
 } // end generic
 
 } // end device
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file workspace_size.h
+ *  \brief The workspace required by the temporaries of generic algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/tuple.h>
+#include <thrust/detail/device/workspace.h>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+/*
+ *  Each function below mirrors the raw_buffer allocations of the
+ *  corresponding generic algorithm applied to trivial iterators and returns
+ *  the largest number of workspace bytes those temporaries occupy at once.
+ *  The temporaries of the scans and copy_ifs they call are accounted for by
+ *  the backend, through the functions declared below.
+ */
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+
+// defined in thrust/detail/device/workspace_size.h
+template<typename T>
+std::size_t scan_workspace_bytes(std::size_t n);
+
+inline std::size_t copy_if_workspace_bytes(std::size_t n);
+
+namespace generic
+{
+
+// predicates and scatter_indices of copy_if
+inline std::size_t copy_if_workspace_bytes(std::size_t n)
+{
+    if (n == 0)
+        return 0;
+
+    // copy_if uses 32-bit indices when possible
+    if (sizeof(std::ptrdiff_t) > sizeof(unsigned int) && n > std::numeric_limits<unsigned int>::max())
+        return 2 * workspace_bytes(n * sizeof(std::ptrdiff_t)) + device::scan_workspace_bytes<std::ptrdiff_t>(n);
+    else
+        return 2 * workspace_bytes(n * sizeof(unsigned int)) + device::scan_workspace_bytes<unsigned int>(n);
+}
+
+// the flags and scanned values of reduce_by_key
+template<typename ValueType>
+std::size_t reduce_by_key_workspace_bytes(std::size_t n)
+{
+    typedef unsigned int FlagType;
+
+    if (n == 0)
+        return 0;
+
+    return 3 * workspace_bytes(n * sizeof(FlagType)) +
+           workspace_bytes(n * sizeof(ValueType)) +
+           std::max(device::scan_workspace_bytes< thrust::tuple<ValueType,FlagType> >(n),
+                    device::scan_workspace_bytes<FlagType>(n));
+}
+
+// the copies of the input and the stencil of unique_by_key
+template<typename KeyType,
+         typename ValueType>
+std::size_t unique_by_key_workspace_bytes(std::size_t n)
+{
+    if (n == 0)
+        return 0;
+
+    return workspace_bytes(n * sizeof(KeyType)) +
+           workspace_bytes(n * sizeof(ValueType)) +
+           workspace_bytes(n * sizeof(int)) +
+           device::copy_if_workspace_bytes(n);
+}
+
+// the head flags of inclusive_segmented_scan
+template<typename OutputType>
+std::size_t inclusive_segmented_scan_workspace_bytes(std::size_t n)
+{
+    typedef unsigned int HeadFlagType;
+
+    if (n == 0)
+        return 0;
+
+    return workspace_bytes(n * sizeof(HeadFlagType)) +
+           device::scan_workspace_bytes< thrust::tuple<OutputType,HeadFlagType> >(n);
+}
+
+// the head flags and shifted input of exclusive_segmented_scan
+template<typename OutputType>
+std::size_t exclusive_segmented_scan_workspace_bytes(std::size_t n)
+{
+    typedef unsigned int HeadFlagType;
+
+    if (n == 0)
+        return 0;
+
+    return workspace_bytes(n * sizeof(HeadFlagType)) +
+           workspace_bytes(n * sizeof(OutputType)) +
+           device::scan_workspace_bytes< thrust::tuple<OutputType,HeadFlagType> >(n);
+}
+
+} // end namespace generic
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
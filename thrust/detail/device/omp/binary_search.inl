@@ -0,0 +1,331 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file binary_search.inl
+ *  \brief Inline file for binary_search.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/generic/binary_search.h>
+#include <thrust/detail/device/omp/detail/merge_path.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// Searching for a sorted sequence of values amounts to merging it with the
+// searched range: the result for a value is the number of elements of the
+// range which precede it in the merge.  The merge is divided evenly among
+// the threads with merge_path, and each thread walks its piece of both
+// sequences once, so m values are found among n elements in O(n + m) time
+// rather than O(m log n).
+//
+// The values are not known to be sorted, and comparing them to each other
+// may not even be possible, so the walk verifies every result instead: an
+// element which precedes the value must lie before the result and the
+// element at the result must not precede it.  When a result fails the test
+// the values are out of order and sorted_search returns false.  The output
+// may be the values themselves, so nothing is written until every thread
+// has verified its results.
+
+struct lower_bound_policy
+{
+    template <typename Element, typename T, typename StrictWeakOrdering>
+    static bool precedes(const Element& element, const T& value, StrictWeakOrdering comp)
+    {
+        return comp(element, value);
+    }
+
+    template <typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+    static Size result(RandomAccessIterator, Size, Size i, const T&, StrictWeakOrdering)
+    {
+        return i;
+    }
+};
+
+struct upper_bound_policy
+{
+    template <typename Element, typename T, typename StrictWeakOrdering>
+    static bool precedes(const Element& element, const T& value, StrictWeakOrdering comp)
+    {
+        return !comp(value, element);
+    }
+
+    template <typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+    static Size result(RandomAccessIterator, Size, Size i, const T&, StrictWeakOrdering)
+    {
+        return i;
+    }
+};
+
+struct binary_search_policy
+  : lower_bound_policy
+{
+    template <typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+    static bool result(RandomAccessIterator first, Size n, Size i, const T& value, StrictWeakOrdering comp)
+    {
+        if (i == n)
+            return false;
+
+        RandomAccessIterator element = first + i;
+
+        return !comp(value, thrust::detail::device::dereference(element));
+    }
+};
+
+// orders an element of the searched range before a value as Policy does,
+// in the form merge_path expects
+template <typename Policy, typename StrictWeakOrdering>
+struct precedes_function
+{
+    StrictWeakOrdering comp;
+
+    precedes_function(StrictWeakOrdering comp) : comp(comp) {}
+
+    template <typename Element, typename T>
+    bool operator()(const Element& element, const T& value)
+    {
+        return Policy::precedes(element, value, comp);
+    }
+};
+
+// whether searching for m values among n elements should merge
+// rather than search for each value independently
+template <typename Size>
+bool prefer_sorted_search(Size n, Size m)
+{
+    Size log_n = 1;
+
+    while ((n >> log_n) > 0)
+        ++log_n;
+
+    return n <= m * log_n;
+}
+
+// walks values [j_begin, j_end) and elements [i_begin, i_end) together,
+// writing the results when write is set, and returns whether every result
+// passed the test
+template <class Policy, class ForwardIterator, class InputIterator, class OutputIterator, class Size, class StrictWeakOrdering>
+bool search_piece(ForwardIterator begin, Size n, Size i_begin, Size i_end,
+                  InputIterator values_begin, Size j_begin, Size j_end,
+                  OutputIterator output,
+                  StrictWeakOrdering comp,
+                  bool write)
+{
+    typedef typename thrust::iterator_value<InputIterator>::type T;
+
+    Size i = i_begin;
+
+    for (Size j = j_begin; j < j_end; ++j)
+    {
+        InputIterator value_iter = values_begin + j;
+
+        T value = thrust::detail::device::dereference(value_iter);
+
+        Size start = i;
+
+        ForwardIterator element = begin + i;
+
+        while (i < i_end && Policy::precedes(thrust::detail::device::dereference(element), value, comp))
+        {
+            ++i;
+            ++element;
+        }
+
+        // the walk stopped at the end of this thread's piece of the range
+        if (i == i_end && i < n && Policy::precedes(thrust::detail::device::dereference(element), value, comp))
+            return false;
+
+        // the walk did not advance past an element preceding value, which
+        // a preceding value would have required
+        if (i == start && i > 0)
+        {
+            ForwardIterator previous = begin + (i - 1);
+
+            if (!Policy::precedes(thrust::detail::device::dereference(previous), value, comp))
+                return false;
+        }
+
+        if (write)
+        {
+            OutputIterator result = output + j;
+
+            thrust::detail::device::dereference(result) = Policy::result(begin, n, i, value, comp);
+        }
+    }
+
+    return true;
+}
+
+template <class Policy, class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
+bool sorted_search(ForwardIterator begin, 
+                   ForwardIterator end,
+                   InputIterator values_begin, 
+                   InputIterator values_end,
+                   OutputIterator output,
+                   StrictWeakOrdering comp)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<ForwardIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+    difference_type n = end - begin;
+    difference_type m = values_end - values_begin;
+
+    bool in_order = true;
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    precedes_function<Policy,StrictWeakOrdering> precedes(comp);
+
+    int P = thrust::detail::device::omp::detail::choose_num_threads(n + m);
+
+    #pragma omp parallel num_threads(P) if (P > 1)
+    {
+        // the runtime may provide fewer threads than requested
+        int num_threads = omp_get_num_threads();
+        int p_i         = omp_get_thread_num();
+
+        difference_type total      = n + m;
+        difference_type chunk      = (total + num_threads - 1) / num_threads;
+        difference_type diag_begin = std::min<difference_type>(chunk * p_i, total);
+        difference_type diag_end   = std::min<difference_type>(chunk * (p_i + 1), total);
+
+        // this thread finds values [j_begin, j_end) among elements [i_begin, i_end)
+        difference_type j_begin = merge_path(values_begin, m, begin, n, diag_begin, precedes);
+        difference_type j_end   = merge_path(values_begin, m, begin, n, diag_end,   precedes);
+        difference_type i_begin = diag_begin - j_begin;
+        difference_type i_end   = diag_end   - j_end;
+
+        bool ok = j_begin <= j_end && i_begin <= i_end &&
+                  search_piece<Policy>(begin, n, i_begin, i_end, values_begin, j_begin, j_end, output, comp, false);
+
+        if (!ok)
+        {
+            #pragma omp critical (thrust_omp_sorted_search)
+            in_order = false;
+        }
+
+        // every thread has read its values before any result is written
+        #pragma omp barrier
+
+        #pragma omp flush(in_order)
+
+        if (in_order)
+            search_piece<Policy>(begin, n, i_begin, i_end, values_begin, j_begin, j_end, output, comp, true);
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return in_order;
+}
+
+template <class Policy, class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
+bool try_sorted_search(ForwardIterator begin, 
+                       ForwardIterator end,
+                       InputIterator values_begin, 
+                       InputIterator values_end,
+                       OutputIterator output,
+                       StrictWeakOrdering comp)
+{
+    typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+    difference_type n = end - begin;
+    difference_type m = values_end - values_begin;
+
+    // few values are cheaper to find independently
+    if (m == 0 || !prefer_sorted_search(n, m))
+        return false;
+
+    return sorted_search<Policy>(begin, end, values_begin, values_end, output, comp);
+}
+
+} // end namespace detail
+
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
+OutputIterator lower_bound(ForwardIterator begin, 
+                           ForwardIterator end,
+                           InputIterator values_begin, 
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    if (detail::try_sorted_search<detail::lower_bound_policy>(begin, end, values_begin, values_end, output, comp))
+        return output + (values_end - values_begin);
+
+    return thrust::detail::device::generic::lower_bound(begin, end, values_begin, values_end, output, comp);
+}
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
+OutputIterator upper_bound(ForwardIterator begin, 
+                           ForwardIterator end,
+                           InputIterator values_begin, 
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    if (detail::try_sorted_search<detail::upper_bound_policy>(begin, end, values_begin, values_end, output, comp))
+        return output + (values_end - values_begin);
+
+    return thrust::detail::device::generic::upper_bound(begin, end, values_begin, values_end, output, comp);
+}
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
+OutputIterator binary_search(ForwardIterator begin, 
+                             ForwardIterator end,
+                             InputIterator values_begin, 
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+    if (detail::try_sorted_search<detail::binary_search_policy>(begin, end, values_begin, values_end, output, comp))
+        return output + (values_end - values_begin);
+
+    return thrust::detail::device::generic::binary_search(begin, end, values_begin, values_end, output, comp);
+}
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
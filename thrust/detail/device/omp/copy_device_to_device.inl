@@ -22,6 +22,10 @@
 #include <thrust/distance.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+#include <thrust/detail/device/omp/detail/trivial_copy.h>
+#include <thrust/detail/dispatch/is_trivial_copy.h>
+#include <thrust/device_ptr.h>
 
 namespace thrust
 {
@@ -35,34 +39,79 @@ namespace device
 namespace omp
 {
 
+namespace detail
+{
+
 template<typename InputIterator,
          typename OutputIterator>
-OutputIterator copy_device_to_device(InputIterator first,
-                                     InputIterator last,
-                                     OutputIterator result)
+struct copy_device_to_device_functor
 {
-  typedef typename thrust::iterator_difference<InputIterator>::type difference;
-  // difference n = thrust::distance(first,last); // XXX WAR crash VS2008 (64-bit)
-  difference n = last - first;
+  InputIterator  first;
+  OutputIterator result;
+
+  copy_device_to_device_functor(InputIterator first, OutputIterator result)
+    : first(first), result(result) {}
 
-// are we compiling with omp support?
-// if no, we serialize on the "host"
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-#pragma omp parallel for
-#endif // omp support
-  for(difference i = 0;
-      i < n;
-      ++i)
+  template<typename Size>
+  void operator()(Size i)
   {
     InputIterator  first_temp  = first  + i;
     OutputIterator result_temp = result + i;
 
-    dereference(result_temp) = dereference(first_temp);
+    thrust::detail::device::dereference(result_temp) = thrust::detail::device::dereference(first_temp);
   }
+}; // end copy_device_to_device_functor
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size>
+OutputIterator copy_device_to_device(InputIterator first,
+                                     Size n,
+                                     OutputIterator result,
+                                     thrust::detail::false_type)
+{
+  // parallelize according to the current execution_config
+  thrust::detail::device::omp::detail::parallel_for
+    (n, detail::copy_device_to_device_functor<InputIterator,OutputIterator>(first, result));
 
   return result + n;
 }
 
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size>
+OutputIterator copy_device_to_device(InputIterator first,
+                                     Size n,
+                                     OutputIterator result,
+                                     thrust::detail::true_type)
+{
+  if (n > 0)
+  {
+    thrust::detail::device::omp::detail::trivial_copy(thrust::raw_pointer_cast(&*first),
+                                                      thrust::raw_pointer_cast(&*first) + n,
+                                                      thrust::raw_pointer_cast(&*result));
+  }
+
+  return result + n;
+}
+
+} // end detail
+
+template<typename InputIterator,
+         typename OutputIterator>
+OutputIterator copy_device_to_device(InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+  // difference n = thrust::distance(first,last); // XXX WAR crash VS2008 (64-bit)
+  difference n = last - first;
+
+  // copy contiguous trivially copyable ranges bytewise
+  return detail::copy_device_to_device(first, n, result,
+    typename thrust::detail::dispatch::is_trivial_copy<InputIterator,OutputIterator>::type());
+}
+
 } // end omp
 
 } // end device
@@ -23,6 +23,10 @@
 #include <thrust/distance.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+#include <thrust/detail/device/omp/detail/trivial_copy.h>
+#include <thrust/detail/dispatch/is_trivial_copy.h>
+#include <thrust/device_ptr.h>
 
 namespace thrust
 {
@@ -36,6 +40,62 @@ namespace device
 namespace omp
 {
 
+namespace detail
+{
+
+template<typename InputIterator,
+         typename OutputIterator>
+struct copy_device_to_host_or_any_functor
+{
+  InputIterator  first;
+  OutputIterator result;
+
+  copy_device_to_host_or_any_functor(InputIterator first, OutputIterator result)
+    : first(first), result(result) {}
+
+  template<typename Size>
+  void operator()(Size i)
+  {
+    InputIterator temp = first + i;
+    result[i] = thrust::detail::device::dereference(temp);
+  }
+}; // end copy_device_to_host_or_any_functor
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size>
+OutputIterator copy_device_to_host_or_any(InputIterator first,
+                                          Size n,
+                                          OutputIterator result,
+                                          thrust::detail::false_type)
+{
+  // parallelize according to the current execution_config
+  thrust::detail::device::omp::detail::parallel_for
+    (n, detail::copy_device_to_host_or_any_functor<InputIterator,OutputIterator>(first, result));
+
+  return result + n;
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size>
+OutputIterator copy_device_to_host_or_any(InputIterator first,
+                                          Size n,
+                                          OutputIterator result,
+                                          thrust::detail::true_type)
+{
+  if (n > 0)
+  {
+    thrust::detail::device::omp::detail::trivial_copy(thrust::raw_pointer_cast(&*first),
+                                                      thrust::raw_pointer_cast(&*first) + n,
+                                                      thrust::raw_pointer_cast(&*result));
+  }
+
+  return result + n;
+}
+
+} // end detail
+
 template<typename InputIterator,
          typename OutputIterator>
 OutputIterator copy_device_to_host_or_any(InputIterator first,
@@ -54,21 +114,9 @@ OutputIterator copy_device_to_host_or_any(InputIterator first,
   // difference n = thrust::distance(first,last); // XXX WAR crash VS2008 (64-bit)
   difference n = last - first;
 
-// do not attempt to compile the body of this function, which depends on #pragma omp,
-// without support from the compiler
-// XXX implement the body of this function in another file to eliminate this ugliness
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-#pragma omp parallel for
-  for(difference i = 0;
-      i < n;
-      ++i)
-  {
-    InputIterator temp = first + i;
-    result[i] = dereference(temp);
-  }
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
-
-  return result + n;
+  // copy contiguous trivially copyable ranges bytewise
+  return detail::copy_device_to_host_or_any(first, n, result,
+    typename thrust::detail::dispatch::is_trivial_copy<InputIterator,OutputIterator>::type());
 }
 
 } // end omp
@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file copy_if.inl
+ *  \brief Inline file for copy_if.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Predicate>
+  OutputIterator copy_if(InputIterator1 first,
+                         InputIterator1 last,
+                         InputIterator2 stencil,
+                         OutputIterator result,
+                         Predicate pred)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator1,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+    difference_type n = last - first;
+
+    if (n == 0)
+        return result;
+
+    difference_type output_size = 0;
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    int P = thrust::detail::device::omp::detail::choose_num_threads(n);
+
+    // offsets[i] is where the survivors of block i begin in the output
+    thrust::detail::raw_omp_device_buffer<difference_type> offsets_buffer(P + 1);
+    difference_type * offsets = thrust::raw_pointer_cast(&*offsets_buffer.begin());
+
+    #pragma omp parallel num_threads(P) if (P > 1)
+    {
+        // the runtime may provide fewer threads than requested
+        int num_threads = omp_get_num_threads();
+        int p_i         = omp_get_thread_num();
+
+        difference_type block_size = (n + num_threads - 1) / num_threads;
+        difference_type begin      = std::min<difference_type>(block_size * p_i, n);
+        difference_type end        = std::min<difference_type>(begin + block_size, n);
+
+        // count the survivors of this thread's block
+        difference_type count = 0;
+
+        for (difference_type i = begin; i < end; i++)
+        {
+            if (pred(thrust::detail::device::dereference(stencil, i)))
+                ++count;
+        }
+
+        offsets[p_i + 1] = count;
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            offsets[0] = 0;
+
+            for (int i = 0; i < num_threads; i++)
+                offsets[i + 1] += offsets[i];
+
+            output_size = offsets[num_threads];
+        }
+
+        // write the survivors directly to their final position
+        difference_type j = offsets[p_i];
+
+        for (difference_type i = begin; i < end; i++)
+        {
+            if (pred(thrust::detail::device::dereference(stencil, i)))
+            {
+                thrust::detail::device::dereference(result, j) = thrust::detail::device::dereference(first, i);
+                ++j;
+            }
+        }
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return result + output_size;
+}
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file merge_path.h
+ *  \brief Partitioning of merges into independent pieces.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <thrust/detail/device/dereference.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// Returns the number of elements of [first1, first1 + n1) among the first
+// diag elements of the stable merge of [first1, first1 + n1) and
+// [first2, first2 + n2).  The remaining diag - result elements come from
+// [first2, first2 + n2).  Splitting a merge at a set of diagonals therefore
+// yields pieces which may be merged independently, e.g. by different threads.
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename StrictWeakOrdering>
+Size merge_path(RandomAccessIterator1 first1, Size n1,
+                RandomAccessIterator2 first2, Size n2,
+                Size diag,
+                StrictWeakOrdering comp)
+{
+    Size lo = (diag > n2) ? diag - n2 : Size(0);
+    Size hi = std::min(diag, n1);
+
+    while (lo < hi)
+    {
+        Size mid = lo + (hi - lo) / 2;
+
+        RandomAccessIterator1 iter1 = first1 + mid;
+        RandomAccessIterator2 iter2 = first2 + (diag - 1 - mid);
+
+        // equivalent elements are taken from the first range first
+        if (comp(thrust::detail::device::dereference(iter2),
+                 thrust::detail::device::dereference(iter1)))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    return lo;
+}
+
+// Returns the position of the first element of [first, first + n) which is
+// not less than value.
+template<typename RandomAccessIterator,
+         typename Size,
+         typename T,
+         typename StrictWeakOrdering>
+Size lower_bound_index(RandomAccessIterator first, Size n,
+                       const T& value,
+                       StrictWeakOrdering comp)
+{
+    Size lo = 0;
+    Size hi = n;
+
+    while (lo < hi)
+    {
+        Size mid = lo + (hi - lo) / 2;
+
+        RandomAccessIterator iter = first + mid;
+
+        if (comp(thrust::detail::device::dereference(iter), value))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+// Splits [first1, first1 + n1) and [first2, first2 + n2) near the given
+// diagonal of their merge, like merge_path, but moves the split backward so
+// that no run of equivalent elements straddles it.  Everything before the
+// split compares less than everything after it, so set operations may be
+// applied to the pieces independently.  The split is returned in i and j.
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename StrictWeakOrdering>
+void set_operation_path(RandomAccessIterator1 first1, Size n1,
+                        RandomAccessIterator2 first2, Size n2,
+                        Size diag,
+                        StrictWeakOrdering comp,
+                        Size& i, Size& j)
+{
+    i = merge_path(first1, n1, first2, n2, diag, comp);
+    j = diag - i;
+
+    // the element following the split in merged order decides where the
+    // run of equivalent elements begins; [first1, first1 + i) and
+    // [first2, first2 + j) precede it in merged order, so only those
+    // prefixes need to be searched
+    RandomAccessIterator1 iter1 = first1 + i;
+    RandomAccessIterator2 iter2 = first2 + j;
+
+    if (i < n1 && (j == n2 || !comp(thrust::detail::device::dereference(iter2),
+                                    thrust::detail::device::dereference(iter1))))
+    {
+        i = lower_bound_index(first1, i, thrust::detail::device::dereference(iter1), comp);
+        j = lower_bound_index(first2, j, thrust::detail::device::dereference(iter1), comp);
+    }
+    else if (j < n2)
+    {
+        i = lower_bound_index(first1, i, thrust::detail::device::dereference(iter2), comp);
+        j = lower_bound_index(first2, j, thrust::detail::device::dereference(iter2), comp);
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
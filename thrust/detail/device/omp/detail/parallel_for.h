@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file parallel_for.h
+ *  \brief Loops over an index range that honor the current execution_config.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/omp/execution_config.h>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+#include <cstddef>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// returns the number of threads which should process n elements under config
+template <typename Size>
+int choose_num_threads(Size n, const execution_config &config)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    if (n < Size(2) || static_cast<std::size_t>(n) < config.serial_cutoff)
+        return 1;
+
+    Size max_threads = config.num_threads > 0 ? config.num_threads : omp_get_max_threads();
+
+    // give every thread at least min_elements_per_thread elements
+    std::size_t grain = std::max<std::size_t>(config.min_elements_per_thread, 1);
+    Size useful_threads = std::max<Size>(Size(1), Size(static_cast<std::size_t>(n) / grain));
+
+    return static_cast<int>(std::min<Size>(max_threads, useful_threads));
+#else
+    return 1;
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end choose_num_threads()
+
+template <typename Size>
+int choose_num_threads(Size n)
+{
+    return choose_num_threads(n, current_execution_config());
+} // end choose_num_threads()
+
+// calls f(i) for every i in [0, n), dividing the iterations among the
+// threads of the enclosing parallel region according to schedule.
+// every thread of the team must call this function
+template <typename Size, typename Function>
+void worksharing_for(Size n, Function f, schedule_kind schedule, Size chunk)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    if (schedule == dynamic_schedule)
+    {
+#       pragma omp for schedule(dynamic, chunk)
+        for (Size i = 0; i < n; i++)
+            f(i);
+    }
+    else
+    {
+#       pragma omp for schedule(static)
+        for (Size i = 0; i < n; i++)
+            f(i);
+    }
+#else
+    for (Size i = 0; i < n; i++)
+        f(i);
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end worksharing_for()
+
+// calls f(i) for every i in [0, n) in parallel under the current execution_config
+template <typename Size, typename Function>
+void parallel_for(Size n, Function f)
+{
+    execution_config config = current_execution_config();
+
+    int P = choose_num_threads(n, config);
+
+    // under a dynamic schedule, hand out chunks of at least min_elements_per_thread
+    // elements, and small enough to give each thread several chunks
+    Size chunk = std::max<Size>(Size(std::max<std::size_t>(config.min_elements_per_thread, 1)),
+                                n / (Size(8) * Size(P)));
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#   pragma omp parallel num_threads(P) if (P > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+    worksharing_for(n, f, config.schedule, chunk);
+} // end parallel_for()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
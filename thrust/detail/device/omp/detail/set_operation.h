@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file set_operation.h
+ *  \brief OpenMP implementation shared by the set operations.
+ */
+
+#pragma once
+
+#include <thrust/pair.h>
+#include <thrust/detail/host/detail/set_operation.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// Applies the set operation described by SetOperationPolicy (see
+// host/detail/set_operation.h) to the sorted ranges
+// [keys_first1, keys_last1) and [keys_first2, keys_last2).  If HasValues is
+// false, the value iterators are ignored.
+template<typename SetOperationPolicy,
+         bool HasValues,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename RandomAccessIterator5,
+         typename RandomAccessIterator6,
+         typename StrictWeakOrdering>
+  thrust::pair<RandomAccessIterator5,RandomAccessIterator6>
+    set_operation(RandomAccessIterator1 keys_first1,
+                  RandomAccessIterator1 keys_last1,
+                  RandomAccessIterator2 keys_first2,
+                  RandomAccessIterator2 keys_last2,
+                  RandomAccessIterator3 values_first1,
+                  RandomAccessIterator4 values_first2,
+                  RandomAccessIterator5 keys_result,
+                  RandomAccessIterator6 values_result,
+                  StrictWeakOrdering comp);
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/omp/detail/set_operation.inl>
+
@@ -0,0 +1,279 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file set_operation.inl
+ *  \brief Inline file for set_operation.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+#include <vector>
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/merge_path.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+/*
+ *  The inputs are cut into one piece per thread with set_operation_path(),
+ *  which never separates equivalent elements, so the set operation may be
+ *  applied to each piece independently.  Every thread first counts the size
+ *  of its piece of the result.  The counts are then scanned to find where
+ *  each piece belongs in the output and, finally, every thread walks its
+ *  piece again, this time writing the result.  Only O(threads) temporary
+ *  storage is needed.
+ */
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+namespace set_operation_detail
+{
+
+template<bool HasValues,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size1,
+         typename Size2>
+void copy_element(RandomAccessIterator1 keys_first,   Size1 i,
+                  RandomAccessIterator2 values_first,
+                  RandomAccessIterator3 keys_result,  Size2 k,
+                  RandomAccessIterator4 values_result)
+{
+    thrust::detail::device::dereference(keys_result, k) = thrust::detail::device::dereference(keys_first, i);
+
+    if (HasValues)
+        thrust::detail::device::dereference(values_result, k) = thrust::detail::device::dereference(values_first, i);
+}
+
+// applies the set operation to [i, i_end) of the first range and [j, j_end)
+// of the second range and returns the size of the result, writing it to
+// keys_result & values_result if WriteOutput is true
+template<typename SetOperationPolicy,
+         bool HasValues,
+         bool WriteOutput,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename RandomAccessIterator5,
+         typename RandomAccessIterator6,
+         typename Size,
+         typename StrictWeakOrdering>
+Size serial_set_operation(RandomAccessIterator1 keys_first1, Size i, Size i_end,
+                          RandomAccessIterator2 keys_first2, Size j, Size j_end,
+                          RandomAccessIterator3 values_first1,
+                          RandomAccessIterator4 values_first2,
+                          RandomAccessIterator5 keys_result,
+                          RandomAccessIterator6 values_result,
+                          StrictWeakOrdering comp)
+{
+    Size count = 0;
+
+    while (i < i_end && j < j_end)
+    {
+        if (comp(thrust::detail::device::dereference(keys_first1, i),
+                 thrust::detail::device::dereference(keys_first2, j)))
+        {
+            if (SetOperationPolicy::keep_first_only)
+            {
+                if (WriteOutput)
+                    copy_element<HasValues>(keys_first1, i, values_first1, keys_result, count, values_result);
+
+                ++count;
+            }
+
+            ++i;
+        }
+        else if (comp(thrust::detail::device::dereference(keys_first2, j),
+                      thrust::detail::device::dereference(keys_first1, i)))
+        {
+            if (SetOperationPolicy::keep_second_only)
+            {
+                if (WriteOutput)
+                    copy_element<HasValues>(keys_first2, j, values_first2, keys_result, count, values_result);
+
+                ++count;
+            }
+
+            ++j;
+        }
+        else
+        {
+            if (SetOperationPolicy::keep_both)
+            {
+                if (WriteOutput)
+                    copy_element<HasValues>(keys_first1, i, values_first1, keys_result, count, values_result);
+
+                ++count;
+            }
+
+            ++i;
+            ++j;
+        }
+    }
+
+    // whatever remains of either range has no equivalent in the other
+    if (SetOperationPolicy::keep_first_only)
+    {
+        if (WriteOutput)
+            for (Size k = 0; k < i_end - i; k++)
+                copy_element<HasValues>(keys_first1, i + k, values_first1, keys_result, count + k, values_result);
+
+        count += i_end - i;
+    }
+
+    if (SetOperationPolicy::keep_second_only)
+    {
+        if (WriteOutput)
+            for (Size k = 0; k < j_end - j; k++)
+                copy_element<HasValues>(keys_first2, j + k, values_first2, keys_result, count + k, values_result);
+
+        count += j_end - j;
+    }
+
+    return count;
+}
+
+} // end namespace set_operation_detail
+
+
+template<typename SetOperationPolicy,
+         bool HasValues,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename RandomAccessIterator5,
+         typename RandomAccessIterator6,
+         typename StrictWeakOrdering>
+  thrust::pair<RandomAccessIterator5,RandomAccessIterator6>
+    set_operation(RandomAccessIterator1 keys_first1,
+                  RandomAccessIterator1 keys_last1,
+                  RandomAccessIterator2 keys_first2,
+                  RandomAccessIterator2 keys_last2,
+                  RandomAccessIterator3 values_first1,
+                  RandomAccessIterator4 values_first2,
+                  RandomAccessIterator5 keys_result,
+                  RandomAccessIterator6 values_result,
+                  StrictWeakOrdering comp)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<RandomAccessIterator1,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+
+    difference_type n1 = keys_last1 - keys_first1;
+    difference_type n2 = keys_last2 - keys_first2;
+
+    difference_type num_elements = n1 + n2;
+    difference_type output_size  = 0;
+
+    if (num_elements == 0)
+        return thrust::make_pair(keys_result, values_result);
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    int P = thrust::detail::device::omp::detail::choose_num_threads(num_elements);
+
+    // splits[2 * k] and splits[2 * k + 1] are the positions where piece k
+    // begins in the first and second range, respectively;
+    // offsets[k] is where piece k begins in the output
+    std::vector<difference_type> splits(2 * (P + 1));
+    std::vector<difference_type> offsets(P + 1);
+
+    #pragma omp parallel num_threads(P) if (P > 1)
+    {
+        // the runtime may provide fewer threads than requested
+        int num_threads = omp_get_num_threads();
+        int p_i         = omp_get_thread_num();
+
+        difference_type chunk = (num_elements + num_threads - 1) / num_threads;
+        difference_type diag  = std::min<difference_type>(chunk * p_i, num_elements);
+
+        set_operation_path(keys_first1, n1, keys_first2, n2, diag, comp, splits[2 * p_i], splits[2 * p_i + 1]);
+
+        if (p_i == 0)
+        {
+            splits[2 * num_threads]     = n1;
+            splits[2 * num_threads + 1] = n2;
+        }
+
+        #pragma omp barrier
+
+        difference_type i_begin = splits[2 * p_i],     i_end = splits[2 * p_i + 2];
+        difference_type j_begin = splits[2 * p_i + 1], j_end = splits[2 * p_i + 3];
+
+        offsets[p_i + 1] =
+          set_operation_detail::serial_set_operation<SetOperationPolicy,HasValues,false>
+            (keys_first1, i_begin, i_end,
+             keys_first2, j_begin, j_end,
+             values_first1, values_first2,
+             keys_result, values_result,
+             comp);
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            offsets[0] = 0;
+
+            for (int i = 0; i < num_threads; i++)
+                offsets[i + 1] += offsets[i];
+
+            output_size = offsets[num_threads];
+        }
+
+        set_operation_detail::serial_set_operation<SetOperationPolicy,HasValues,true>
+          (keys_first1, i_begin, i_end,
+           keys_first2, j_begin, j_end,
+           values_first1, values_first2,
+           keys_result + offsets[p_i], values_result + offsets[p_i],
+           comp);
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return thrust::make_pair(keys_result + output_size, values_result + output_size);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,164 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file shift_blocks.h
+ *  \brief Moves the compacted blocks of an in-place algorithm together.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/dereference.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// Each of the num_threads blocks of [first, first + n) has been compacted
+// in place, so that block i holds offsets[i + 1] - offsets[i] elements
+// at its beginning.  shift_blocks moves the blocks together so that the
+// elements of block i occupy [first + offsets[i], first + offsets[i + 1]).
+//
+// Every block moves left, so the blocks are moved in order and each move
+// may only overwrite elements which have already been moved.  A block which
+// travels far is moved in rounds no longer than the distance it travels, so
+// that every round reads elements which no other thread writes.  A block
+// which travels a short distance is moved in rounds of min_round_per_thread
+// elements per thread: each thread first saves the last elements of its
+// part, which the next parts overwrite, to a scratch buffer of
+// min_round_per_thread elements.  Blocks too short to be worth dividing are
+// moved by a single thread.
+//
+// Every thread of the team must call this function.
+template<typename RandomAccessIterator,
+         typename Size>
+void shift_blocks(RandomAccessIterator first,
+                  Size n,
+                  const Size *offsets,
+                  int num_threads,
+                  int p_i)
+{
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+    const Size min_round_per_thread = 1 << 12;
+
+    Size block_size = (n + num_threads - 1) / num_threads;
+
+    // whether any block is moved through the scratch buffers
+    bool staged = false;
+
+    for (int block = 1; block < num_threads; block++)
+    {
+        Size src   = std::min<Size>(block_size * block, n);
+        Size dst   = offsets[block];
+        Size count = offsets[block + 1] - dst;
+
+        if (count >= min_round_per_thread * num_threads && src - dst < min_round_per_thread * num_threads)
+            staged = true;
+    }
+
+    // each thread allocates its own scratch buffer, outside any workspace
+    thrust::detail::raw_buffer<value_type, thrust::host_space_tag> tail_buffer(staged ? min_round_per_thread : 0);
+    value_type * tail = staged ? &tail_buffer[0] : 0;
+
+    // block 0 never moves
+    for (int block = 1; block < num_threads; block++)
+    {
+        Size src   = std::min<Size>(block_size * block, n);
+        Size dst   = offsets[block];
+        Size count = offsets[block + 1] - dst;
+
+        if (count == 0 || src == dst)
+            continue;
+
+        Size distance = src - dst;
+
+        if (count < min_round_per_thread * num_threads)
+        {
+#           pragma omp single
+            {
+                for (Size i = 0; i < count; i++)
+                    thrust::detail::device::dereference(first, dst + i) = thrust::detail::device::dereference(first, src + i);
+            }
+        }
+        else if (distance < min_round_per_thread * num_threads)
+        {
+            for (Size round = 0; round < count; round += min_round_per_thread * num_threads)
+            {
+                Size len   = std::min<Size>(min_round_per_thread * num_threads, count - round);
+                Size chunk = (len + num_threads - 1) / num_threads;
+                Size begin = round + std::min<Size>(chunk * p_i, len);
+                Size end   = round + std::min<Size>(chunk * (p_i + 1), len);
+
+                // the next parts overwrite the last distance elements of this part
+                Size tail_begin = std::max<Size>(begin, end - distance);
+
+                for (Size i = tail_begin; i < end; i++)
+                    tail[i - tail_begin] = thrust::detail::device::dereference(first, src + i);
+
+#               pragma omp barrier
+
+                for (Size i = begin; i < tail_begin; i++)
+                    thrust::detail::device::dereference(first, dst + i) = thrust::detail::device::dereference(first, src + i);
+
+                for (Size i = tail_begin; i < end; i++)
+                    thrust::detail::device::dereference(first, dst + i) = tail[i - tail_begin];
+
+#               pragma omp barrier
+            }
+        }
+        else
+        {
+            for (Size round = 0; round < count; round += distance)
+            {
+                Size len   = std::min<Size>(distance, count - round);
+                Size chunk = (len + num_threads - 1) / num_threads;
+                Size begin = round + std::min<Size>(chunk * p_i, len);
+                Size end   = round + std::min<Size>(chunk * (p_i + 1), len);
+
+                for (Size i = begin; i < end; i++)
+                    thrust::detail::device::dereference(first, dst + i) = thrust::detail::device::dereference(first, src + i);
+
+#               pragma omp barrier
+            }
+        }
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
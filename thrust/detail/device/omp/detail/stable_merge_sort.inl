@@ -19,13 +19,24 @@
 #include <omp.h>
 #endif // omp support
 
-//#include <thrust/detail/host/sort.h>
 #include <algorithm>
 
-#include <thrust/iterator/detail/forced_iterator.h> // XXX remove this we we have a proper OMP sort
 #include <thrust/iterator/iterator_traits.h>
-#include <thrust/detail/device/omp/dispatch/sort.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/host/detail/stable_merge_sort.h>
+#include <thrust/detail/device/omp/detail/merge_path.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
 
+/*
+ *  Both sorts below proceed in two phases.  First, the input is split into
+ *  one tile per thread and every thread sorts its own tile.  Next, sorted runs
+ *  are merged pairwise, level by level, ping-ponging between the input and a
+ *  temporary buffer.  At every level the output is divided into equal pieces,
+ *  one per thread, and merge_path() locates the corresponding pieces of the
+ *  input runs.  Hence all threads participate in every merge, including the
+ *  final one.
+ */
 
 namespace thrust
 {
@@ -57,54 +68,232 @@ void stable_merge_sort(RandomAccessIterator first,
 // XXX implement the body of this function in another file to eliminate this ugliness
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
 
-    unsigned int P = omp_get_max_threads();
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type      KeyType;
+    typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
 
-    // tiles processed by each processor
-    unsigned int keycount  = last - first;
-    unsigned int blocksize = (keycount + P - 1) / P;
-    std::vector<unsigned int> begin(P), end(P);
+    difference_type keycount = last - first;
 
-    omp_set_num_threads(P);
+    if (keycount < 2)
+        return;
 
-    #pragma omp parallel
-    {
-        int p_i = omp_get_thread_num();
+    int P = thrust::detail::device::omp::detail::choose_num_threads(keycount);
+
+    thrust::detail::raw_omp_device_buffer<KeyType> temp(keycount);
+
+    // RandomAccessIterator is trivial, so work with raw pointers
+    KeyType * keys      = thrust::raw_pointer_cast(&*first);
+    KeyType * keys_temp = thrust::raw_pointer_cast(&*temp.begin());
 
-        begin[p_i] = blocksize * p_i;
-        end[p_i]   = std::min(begin[p_i]+blocksize, keycount);
+    #pragma omp parallel num_threads(P) if (P > 1)
+    {
+        // the runtime may provide fewer threads than requested
+        int num_threads = omp_get_num_threads();
+        int p_i         = omp_get_thread_num();
 
-        //fprintf(stderr, "Range %d = [%d, %d)\n", p_i, begin[p_i], end[p_i]);
+        difference_type blocksize = (keycount + num_threads - 1) / num_threads;
+        difference_type begin     = std::min<difference_type>(blocksize * p_i, keycount);
+        difference_type end       = std::min<difference_type>(begin + blocksize, keycount);
 
         // Every thread sorts its own tile
-        std::stable_sort(thrust::raw_pointer_cast(&*first) + begin[p_i],
-                         thrust::raw_pointer_cast(&*first) + end[p_i],
-                         comp);
+        std::stable_sort(keys + begin, keys + end, comp);
+
+        KeyType * src = keys;
+        KeyType * dst = keys_temp;
+
+        // merge runs of size width into runs of size 2 * width
+        for (difference_type width = blocksize; width < keycount; width *= 2)
+        {
+            #pragma omp barrier
+
+            // every run pair overlapping this thread's piece of the output
+            for (difference_type pair_begin = (begin / (2 * width)) * (2 * width);
+                 pair_begin < end;
+                 pair_begin += 2 * width)
+            {
+                difference_type pair_middle = std::min<difference_type>(pair_begin + width,     keycount);
+                difference_type pair_end    = std::min<difference_type>(pair_begin + 2 * width, keycount);
+
+                difference_type n1 = pair_middle - pair_begin;
+                difference_type n2 = pair_end    - pair_middle;
+
+                // the piece of this pair's output belonging to this thread
+                difference_type diag_begin = std::max<difference_type>(begin, pair_begin) - pair_begin;
+                difference_type diag_end   = std::min<difference_type>(end,   pair_end)   - pair_begin;
+
+                difference_type i_begin = merge_path(src + pair_begin, n1, src + pair_middle, n2, diag_begin, comp);
+                difference_type i_end   = merge_path(src + pair_begin, n1, src + pair_middle, n2, diag_end,   comp);
+
+                std::merge(src + pair_begin  + i_begin,                src + pair_begin  + i_end,
+                           src + pair_middle + (diag_begin - i_begin), src + pair_middle + (diag_end - i_end),
+                           dst + pair_begin  + diag_begin,
+                           comp);
+            }
+
+            std::swap(src, dst);
+        }
 
-        #pragma omp barrier
+        // copy the result back to the input, if necessary
+        if (src != keys)
+        {
+            #pragma omp barrier
+
+            std::copy(src + begin, src + end, keys + begin);
+        }
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+// sorts the tile [keys, keys + n) and its values without allocating memory,
+// using the same tile of the temporary buffers for the merges
+template<typename KeyType,
+         typename ValueType,
+         typename Size,
+         typename StrictWeakOrdering>
+void sort_tile_by_key(KeyType * keys,
+                      ValueType * values,
+                      KeyType * keys_temp,
+                      ValueType * values_temp,
+                      Size n,
+                      StrictWeakOrdering comp)
+{
+    const Size run_size = 32;
 
-        unsigned int nseg=P, h=2;
+    for (Size i = 0; i < n; i += run_size)
+        thrust::detail::host::detail::insertion_sort_by_key(keys + i, keys + std::min<Size>(i + run_size, n), values + i, comp);
 
-        // keep track of which sub-range we're processing
-        unsigned int a=p_i, b=p_i, c=p_i+1;
+    KeyType   * keys_src   = keys;
+    KeyType   * keys_dst   = keys_temp;
+    ValueType * values_src = values;
+    ValueType * values_dst = values_temp;
 
-        while( nseg>1 )
+    for (Size width = run_size; width < n; width *= 2)
+    {
+        for (Size i = 0; i < n; i += 2 * width)
         {
-            if( c>=P )  c=P-1;
+            Size middle = std::min<Size>(i + width,     n);
+            Size last   = std::min<Size>(i + 2 * width, n);
+
+            thrust::detail::host::detail::merge_by_key(keys_src + i,      keys_src + middle,
+                                                       keys_src + middle, keys_src + last,
+                                                       values_src + i,    values_src + middle,
+                                                       keys_dst + i,      values_dst + i,
+                                                       comp);
+        }
+
+        std::swap(keys_src,   keys_dst);
+        std::swap(values_src, values_dst);
+    }
+
+    if (keys_src != keys)
+    {
+        std::copy(keys_src,   keys_src   + n, keys);
+        std::copy(values_src, values_src + n, values);
+    }
+}
 
-            if( (p_i%h)==0 && c>b )
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_merge_sort_by_key(RandomAccessIterator1 keys_first,
+                              RandomAccessIterator1 keys_last,
+                              RandomAccessIterator2 values_first,
+                              StrictWeakOrdering comp)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<RandomAccessIterator1,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+    typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+    typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+
+    difference_type keycount = keys_last - keys_first;
+
+    if (keycount < 2)
+        return;
+
+    int P = thrust::detail::device::omp::detail::choose_num_threads(keycount);
+
+    thrust::detail::raw_omp_device_buffer<KeyType>   keys_buffer(keycount);
+    thrust::detail::raw_omp_device_buffer<ValueType> values_buffer(keycount);
+
+    // RandomAccessIterator1 & RandomAccessIterator2 are trivial, so work with raw pointers
+    KeyType   * keys        = thrust::raw_pointer_cast(&*keys_first);
+    ValueType * values      = thrust::raw_pointer_cast(&*values_first);
+    KeyType   * keys_temp   = thrust::raw_pointer_cast(&*keys_buffer.begin());
+    ValueType * values_temp = thrust::raw_pointer_cast(&*values_buffer.begin());
+
+    #pragma omp parallel num_threads(P) if (P > 1)
+    {
+        // the runtime may provide fewer threads than requested
+        int num_threads = omp_get_num_threads();
+        int p_i         = omp_get_thread_num();
+
+        difference_type blocksize = (keycount + num_threads - 1) / num_threads;
+        difference_type begin     = std::min<difference_type>(blocksize * p_i, keycount);
+        difference_type end       = std::min<difference_type>(begin + blocksize, keycount);
+
+        // Every thread sorts its own tile
+        sort_tile_by_key(keys + begin, values + begin, keys_temp + begin, values_temp + begin, end - begin, comp);
+
+        KeyType   * keys_src   = keys;
+        KeyType   * keys_dst   = keys_temp;
+        ValueType * values_src = values;
+        ValueType * values_dst = values_temp;
+
+        // merge runs of size width into runs of size 2 * width
+        for (difference_type width = blocksize; width < keycount; width *= 2)
+        {
+            #pragma omp barrier
+
+            // every run pair overlapping this thread's piece of the output
+            for (difference_type pair_begin = (begin / (2 * width)) * (2 * width);
+                 pair_begin < end;
+                 pair_begin += 2 * width)
             {
-                // Every thread sorts its own tile
-                std::inplace_merge(thrust::raw_pointer_cast(&*first) + begin[a],
-                                   thrust::raw_pointer_cast(&*first) + end[b],
-                                   thrust::raw_pointer_cast(&*first) + end[c],
-                                   comp);
-                b  = c;
-                c += h;
+                difference_type pair_middle = std::min<difference_type>(pair_begin + width,     keycount);
+                difference_type pair_end    = std::min<difference_type>(pair_begin + 2 * width, keycount);
+
+                difference_type n1 = pair_middle - pair_begin;
+                difference_type n2 = pair_end    - pair_middle;
+
+                // the piece of this pair's output belonging to this thread
+                difference_type diag_begin = std::max<difference_type>(begin, pair_begin) - pair_begin;
+                difference_type diag_end   = std::min<difference_type>(end,   pair_end)   - pair_begin;
+
+                difference_type i_begin = merge_path(keys_src + pair_begin, n1, keys_src + pair_middle, n2, diag_begin, comp);
+                difference_type i_end   = merge_path(keys_src + pair_begin, n1, keys_src + pair_middle, n2, diag_end,   comp);
+
+                thrust::detail::host::detail::merge_by_key
+                    (keys_src   + pair_begin  + i_begin,                keys_src + pair_begin  + i_end,
+                     keys_src   + pair_middle + (diag_begin - i_begin), keys_src + pair_middle + (diag_end - i_end),
+                     values_src + pair_begin  + i_begin,
+                     values_src + pair_middle + (diag_begin - i_begin),
+                     keys_dst   + pair_begin  + diag_begin,
+                     values_dst + pair_begin  + diag_begin,
+                     comp);
             }
 
-            nseg = (nseg+1)/2;
-            h *= 2;
+            std::swap(keys_src,   keys_dst);
+            std::swap(values_src, values_dst);
+        }
+
+        // copy the result back to the input, if necessary
+        if (keys_src != keys)
+        {
             #pragma omp barrier
+
+            std::copy(keys_src   + begin, keys_src   + end, keys   + begin);
+            std::copy(values_src + begin, values_src + end, values + begin);
         }
     }
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
@@ -0,0 +1,342 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// unsigned integer type with the same width as a key
+template<unsigned int N> struct radix_sort_bits {};
+template<> struct radix_sort_bits<1> { typedef unsigned char      type; };
+template<> struct radix_sort_bits<2> { typedef unsigned short     type; };
+template<> struct radix_sort_bits<4> { typedef unsigned int       type; };
+template<> struct radix_sort_bits<8> { typedef unsigned long long type; };
+
+
+// radix_encoder maps a key to an unsigned integer such that comparing the
+// integers as unsigned values orders them the same way as comparing the keys
+template<typename KeyType,
+         bool is_integer = std::numeric_limits<KeyType>::is_integer,
+         bool is_signed  = std::numeric_limits<KeyType>::is_signed>
+  struct radix_encoder
+{
+  // floating point: flip every bit of negative values, only the sign bit of others
+  typedef typename radix_sort_bits<sizeof(KeyType)>::type bits_type;
+
+  static const bits_type sign_bit = bits_type(1) << (8 * sizeof(KeyType) - 1);
+
+  static bits_type encode(KeyType key)
+  {
+    bits_type bits;
+    std::memcpy(&bits, &key, sizeof(KeyType));
+    return (bits & sign_bit) ? bits_type(~bits) : bits_type(bits ^ sign_bit);
+  }
+
+  static KeyType decode(bits_type bits)
+  {
+    bits = (bits & sign_bit) ? bits_type(bits ^ sign_bit) : bits_type(~bits);
+    KeyType key;
+    std::memcpy(&key, &bits, sizeof(KeyType));
+    return key;
+  }
+};
+
+template<typename KeyType>
+  struct radix_encoder<KeyType, true, true>
+{
+  // signed integer: flip the sign bit
+  typedef typename radix_sort_bits<sizeof(KeyType)>::type bits_type;
+
+  static const bits_type sign_bit = bits_type(1) << (8 * sizeof(KeyType) - 1);
+
+  static bits_type encode(KeyType key)
+  {
+    bits_type bits;
+    std::memcpy(&bits, &key, sizeof(KeyType));
+    return bits ^ sign_bit;
+  }
+
+  static KeyType decode(bits_type bits)
+  {
+    bits ^= sign_bit;
+    KeyType key;
+    std::memcpy(&key, &bits, sizeof(KeyType));
+    return key;
+  }
+};
+
+template<typename KeyType>
+  struct radix_encoder<KeyType, true, false>
+{
+  // unsigned integer: nothing to do
+  typedef typename radix_sort_bits<sizeof(KeyType)>::type bits_type;
+
+  static bits_type encode(KeyType key)
+  {
+    bits_type bits;
+    std::memcpy(&bits, &key, sizeof(KeyType));
+    return bits;
+  }
+
+  static KeyType decode(bits_type bits)
+  {
+    KeyType key;
+    std::memcpy(&key, &bits, sizeof(KeyType));
+    return key;
+  }
+};
+
+
+// sorting with greater<KeyType> sorts the complemented encoding
+template<typename KeyType, typename StrictWeakOrdering>
+  struct radix_key_codec
+{
+  typedef radix_encoder<KeyType>          encoder;
+  typedef typename encoder::bits_type     bits_type;
+
+  static const bool descending = thrust::detail::is_same<StrictWeakOrdering, thrust::greater<KeyType> >::value;
+
+  static bits_type encode(KeyType key)
+  {
+    return descending ? bits_type(~encoder::encode(key)) : encoder::encode(key);
+  }
+
+  static KeyType decode(bits_type bits)
+  {
+    return encoder::decode(descending ? bits_type(~bits) : bits);
+  }
+};
+
+
+// placeholder value type for key-only sorts
+struct radix_sort_no_values {};
+
+
+// LSD radix sort on 8-bit digits.  Each pass every thread histograms the
+// digits of its own block, one thread turns the histograms into per-thread
+// scatter offsets (ordered by digit, then by thread, which keeps the sort
+// stable), and then every thread scatters its block.  Passes whose digit is
+// identical for every key are skipped.
+//
+// NOTE: like the CUDA radix sort, -0.0 is ordered before +0.0
+template<bool HasValues,
+         typename KeyType,
+         typename ValueType,
+         typename StrictWeakOrdering>
+void radix_sort(KeyType * keys,
+                ValueType * values,
+                ValueType * values_temp,
+                std::ptrdiff_t n,
+                StrictWeakOrdering)
+{
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    typedef radix_key_codec<KeyType,StrictWeakOrdering> codec;
+    typedef typename codec::bits_type                    bits_type;
+
+    const unsigned int num_buckets = 256;
+    const unsigned int num_passes  = sizeof(KeyType);
+
+    if (n < 2)
+        return;
+
+    int P = thrust::detail::device::omp::detail::choose_num_threads(n);
+
+    thrust::detail::raw_omp_device_buffer<bits_type> bits_buffer1(n);
+    thrust::detail::raw_omp_device_buffer<bits_type> bits_buffer2(n);
+
+    bits_type * bits1 = thrust::raw_pointer_cast(&*bits_buffer1.begin());
+    bits_type * bits2 = thrust::raw_pointer_cast(&*bits_buffer2.begin());
+
+    // histograms[p_i * num_buckets + digit] counts, then offsets, thread p_i's keys
+    thrust::detail::raw_omp_device_buffer<std::ptrdiff_t> histograms_buffer(P * num_buckets);
+    std::ptrdiff_t * histograms = thrust::raw_pointer_cast(&*histograms_buffer.begin());
+
+    bool skip_pass = false;
+
+    #pragma omp parallel num_threads(P) if (P > 1)
+    {
+        // the runtime may provide fewer threads than requested
+        int num_threads = omp_get_num_threads();
+        int p_i         = omp_get_thread_num();
+
+        std::ptrdiff_t blocksize = (n + num_threads - 1) / num_threads;
+        std::ptrdiff_t begin     = std::min<std::ptrdiff_t>(blocksize * p_i, n);
+        std::ptrdiff_t end       = std::min<std::ptrdiff_t>(begin + blocksize, n);
+
+        std::ptrdiff_t * histogram = &histograms[p_i * num_buckets];
+
+        bits_type * bits_src   = bits1;
+        bits_type * bits_dst   = bits2;
+        ValueType * values_src = values;
+        ValueType * values_dst = values_temp;
+
+        for (std::ptrdiff_t i = begin; i < end; i++)
+            bits_src[i] = codec::encode(keys[i]);
+
+        for (unsigned int pass = 0; pass < num_passes; pass++)
+        {
+            const unsigned int shift = 8 * pass;
+
+            std::fill(histogram, histogram + num_buckets, std::ptrdiff_t(0));
+
+            for (std::ptrdiff_t i = begin; i < end; i++)
+                histogram[(bits_src[i] >> shift) & (num_buckets - 1)]++;
+
+            #pragma omp barrier
+
+            #pragma omp single
+            {
+                std::ptrdiff_t sum = 0;
+
+                skip_pass = false;
+
+                for (unsigned int digit = 0; digit < num_buckets; digit++)
+                {
+                    std::ptrdiff_t digit_begin = sum;
+
+                    for (int p = 0; p < num_threads; p++)
+                    {
+                        std::ptrdiff_t count = histograms[p * num_buckets + digit];
+                        histograms[p * num_buckets + digit] = sum;
+                        sum += count;
+                    }
+
+                    // every key has this digit
+                    if (sum - digit_begin == n)
+                        skip_pass = true;
+                }
+            }
+
+            if (skip_pass)
+                continue;
+
+            for (std::ptrdiff_t i = begin; i < end; i++)
+            {
+                std::ptrdiff_t offset = histogram[(bits_src[i] >> shift) & (num_buckets - 1)]++;
+
+                bits_dst[offset] = bits_src[i];
+
+                if (HasValues)
+                    values_dst[offset] = values_src[i];
+            }
+
+            std::swap(bits_src, bits_dst);
+            std::swap(values_src, values_dst);
+
+            #pragma omp barrier
+        }
+
+        for (std::ptrdiff_t i = begin; i < end; i++)
+            keys[i] = codec::decode(bits_src[i]);
+
+        if (HasValues && values_src != values)
+            std::copy(values_src + begin, values_src + end, values + begin);
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_radix_sort(RandomAccessIterator first,
+                       RandomAccessIterator last,
+                       StrictWeakOrdering comp)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<RandomAccessIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+    // RandomAccessIterator is trivial, so work with raw pointers
+    KeyType * keys = thrust::raw_pointer_cast(&*first);
+
+    radix_sort<false>(keys,
+                      static_cast<radix_sort_no_values *>(0),
+                      static_cast<radix_sort_no_values *>(0),
+                      last - first,
+                      comp);
+}
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_radix_sort_by_key(RandomAccessIterator1 keys_first,
+                              RandomAccessIterator1 keys_last,
+                              RandomAccessIterator2 values_first,
+                              StrictWeakOrdering comp)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<RandomAccessIterator1,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+    typedef typename thrust::iterator_value<RandomAccessIterator2>::type ValueType;
+
+    // RandomAccessIterator1 & RandomAccessIterator2 are trivial, so work with raw pointers
+    KeyType   * keys   = thrust::raw_pointer_cast(&*keys_first);
+    ValueType * values = thrust::raw_pointer_cast(&*values_first);
+
+    thrust::detail::raw_omp_device_buffer<ValueType> values_temp(keys_last - keys_first);
+
+    radix_sort<true>(keys,
+                     values,
+                     thrust::raw_pointer_cast(&*values_temp.begin()),
+                     keys_last - keys_first,
+                     comp);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
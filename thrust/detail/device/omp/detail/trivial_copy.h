@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file trivial_copy.h
+ *  \brief Parallel copy of contiguous trivially copyable ranges.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define __THRUST_HAS_STREAMING_STORES 1
+#else
+#define __THRUST_HAS_STREAMING_STORES 0
+#endif // SSE2
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+// copies of at least this many bytes bypass the cache with non-temporal
+// stores, where the processor supports them.  zero disables them
+#ifndef THRUST_OMP_STREAMING_COPY_THRESHOLD
+#define THRUST_OMP_STREAMING_COPY_THRESHOLD (std::size_t(32) << 20)
+#endif // THRUST_OMP_STREAMING_COPY_THRESHOLD
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// copies n bytes with non-temporal stores, so that a copy larger than the
+// cache does not evict its contents nor read the destination beforehand
+inline void streaming_copy(char *result, const char *first, std::size_t n)
+{
+#if __THRUST_HAS_STREAMING_STORES
+    // copy the bytes before the first 16-byte boundary of the destination
+    std::size_t head = std::min<std::size_t>((16 - reinterpret_cast<std::size_t>(result) % 16) % 16, n);
+
+    std::memcpy(result, first, head);
+    result += head;
+    first  += head;
+    n      -= head;
+
+    // stream whole cache lines
+    std::size_t body = n / 64 * 64;
+
+    for (std::size_t i = 0; i < body; i += 64)
+    {
+        __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + 16));
+        __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + 32));
+        __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + 48));
+
+        _mm_stream_si128(reinterpret_cast<__m128i*>(result + i),      x0);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(result + i + 16), x1);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(result + i + 32), x2);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(result + i + 48), x3);
+    }
+
+    std::memcpy(result + body, first + body, n - body);
+
+    // order the streaming stores before the stores which follow the copy
+    _mm_sfence();
+#else
+    std::memcpy(result, first, n);
+#endif // __THRUST_HAS_STREAMING_STORES
+} // end streaming_copy()
+
+// copies [first, last) to result in one contiguous range of bytes per
+// thread.  the team is chosen as for an element-wise copy of the range
+template<typename T>
+  T *trivial_copy(const T *first,
+                  const T *last,
+                        T *result)
+{
+    std::ptrdiff_t n = last - first;
+
+    const char *src = reinterpret_cast<const char*>(first);
+    char       *dst = reinterpret_cast<char*>(result);
+
+    std::size_t num_bytes = n * sizeof(T);
+
+    int P = choose_num_threads(n);
+
+    // overlapping ranges must be copied in order
+    bool overlap = (dst < src + num_bytes) && (src < dst + num_bytes);
+
+    if (P < 2 || overlap)
+    {
+        std::memmove(dst, src, num_bytes);
+        return result + n;
+    }
+
+    bool streaming = THRUST_OMP_STREAMING_COPY_THRESHOLD > 0 && num_bytes >= THRUST_OMP_STREAMING_COPY_THRESHOLD;
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    #pragma omp parallel num_threads(P)
+    {
+        // the runtime may provide fewer threads than requested
+        std::size_t num_threads = omp_get_num_threads();
+        std::size_t p_i         = omp_get_thread_num();
+
+        // the blocks meet at 64-byte boundaries of the destination address,
+        // so no two threads store to the same cache line.  the first block
+        // also takes the bytes before the first boundary
+        std::size_t misalignment = reinterpret_cast<std::size_t>(dst) % 64;
+        std::size_t head         = std::min<std::size_t>((64 - misalignment) % 64, num_bytes);
+
+        std::size_t blocksize = (num_bytes - head + num_threads - 1) / num_threads;
+        blocksize = (blocksize + 63) / 64 * 64;
+
+        std::size_t begin = (p_i == 0) ? 0 : std::min(head + blocksize * p_i, num_bytes);
+        std::size_t end   = std::min(head + blocksize * (p_i + 1), num_bytes);
+
+        if (streaming)
+            streaming_copy(dst + begin, src + begin, end - begin);
+        else
+            std::memcpy(dst + begin, src + begin, end - begin);
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return result + n;
+} // end trivial_copy()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
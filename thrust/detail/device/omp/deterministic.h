@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file deterministic.h
+ *  \brief Opt-in thread count independent reductions and scans
+ *         for the OpenMP backend.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+namespace detail
+{
+
+// the mode of the calling thread, which, like its execution_config, is
+// unaffected by the scopes of other threads
+inline bool &deterministic_reductions_flag(void)
+{
+    static bool flag = false;
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#pragma omp threadprivate(flag)
+#endif // omp support
+    return flag;
+} // end deterministic_reductions_flag()
+
+// the number of elements per block in deterministic mode
+static const unsigned int deterministic_block_size = 1 << 12;
+
+// returns the number of blocks a reduction or scan of n elements
+// should be split into when num_threads threads are available
+template <typename Size>
+Size reduction_num_blocks(Size n, Size num_threads)
+{
+    if (deterministic_reductions_flag())
+        return (n + Size(deterministic_block_size) - 1) / Size(deterministic_block_size);
+    else
+        return num_threads;
+} // end reduction_num_blocks()
+
+} // end namespace detail
+
+/*! By default, \p reduce, \p transform_reduce, \p inner_product and the scans
+ *  split their input into one block per thread.  When the operator is not
+ *  exactly associative (e.g. floating point addition), the result then depends
+ *  on the number of threads.
+ *
+ *  In deterministic mode the block boundaries and the order in which blocks
+ *  are combined depend only on the size of the input, so the result is
+ *  bitwise identical for any number of threads.  Blocks are still processed
+ *  in parallel.
+ *
+ *  The mode is set per host thread.
+ *
+ *  \return \c true if deterministic mode is enabled on the calling thread.
+ */
+inline bool deterministic_reductions(void)
+{
+    return detail::deterministic_reductions_flag();
+} // end deterministic_reductions()
+
+/*! Enables or disables deterministic mode for subsequent calls on the
+ *  calling thread.
+ */
+inline void set_deterministic_reductions(bool enable)
+{
+    detail::deterministic_reductions_flag() = enable;
+} // end set_deterministic_reductions()
+
+/*! \p scoped_deterministic_reductions enables (or disables) deterministic mode
+ *  for its lifetime and restores the previous mode upon destruction.
+ */
+class scoped_deterministic_reductions
+{
+  public:
+    explicit scoped_deterministic_reductions(bool enable = true)
+      : m_previous(deterministic_reductions())
+    {
+        set_deterministic_reductions(enable);
+    }
+
+    ~scoped_deterministic_reductions(void)
+    {
+        set_deterministic_reductions(m_previous);
+    }
+
+  private:
+    bool m_previous;
+
+    // noncopyable
+    scoped_deterministic_reductions(const scoped_deterministic_reductions &);
+    scoped_deterministic_reductions &operator=(const scoped_deterministic_reductions &);
+}; // end scoped_deterministic_reductions
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -20,6 +20,7 @@
 #include <thrust/device_ptr.h>
 #include <algorithm>
 #include <thrust/detail/host/sort.h>
+#include <thrust/detail/device/omp/detail/stable_merge_sort.h>
 
 #include <thrust/iterator/detail/forced_iterator.h> // XXX remove this we we have a proper OMP sort
 
@@ -42,10 +43,8 @@ template<typename RandomAccessIterator, typename StrictWeakOrdering>
 void stable_sort(RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp,
                  thrust::detail::true_type)
 {
-  // RandomAccessIterator is trivial, so cast to a raw pointer and use std::stable_sort
-  std::stable_sort(thrust::raw_pointer_cast(&*first),
-                   thrust::raw_pointer_cast(&*last),
-                   comp);
+  // RandomAccessIterator is trivial, so use the parallel merge sort
+  thrust::detail::device::omp::detail::stable_merge_sort(first, last, comp);
 }
 
 template<typename RandomAccessIterator, typename StrictWeakOrdering>
@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file execution_config.h
+ *  \brief Scoped execution configuration for the OpenMP backend.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <cstddef>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+/*! \p schedule_kind selects how the iterations of an element-wise
+ *  loop (e.g. \p for_each or \p copy) are distributed among threads.
+ */
+enum schedule_kind
+{
+  /*! Each thread receives one contiguous range of iterations.
+   */
+  static_schedule,
+
+  /*! Threads repeatedly claim chunks of iterations as they finish
+   *  their previous chunk.  This suits irregular per-element work.
+   */
+  dynamic_schedule
+};
+
+/*! \p execution_config describes how the OpenMP backend parallelizes a call.
+ *  The default configuration reproduces the default behavior of the backend:
+ *  one thread per available processor, with no serial cutoff.
+ */
+struct execution_config
+{
+  /*! The maximum number of threads to use.  Zero means the value
+   *  of \c omp_get_max_threads().
+   */
+  int num_threads;
+
+  /*! The minimum number of elements each thread should process.
+   *  Smaller inputs use fewer threads.
+   */
+  std::size_t min_elements_per_thread;
+
+  /*! The schedule of element-wise loops.
+   */
+  schedule_kind schedule;
+
+  /*! Inputs with fewer elements than this are processed by the
+   *  calling thread without starting a parallel region.
+   */
+  std::size_t serial_cutoff;
+
+  execution_config(void)
+    : num_threads(0),
+      min_elements_per_thread(1),
+      schedule(static_schedule),
+      serial_cutoff(0)
+  {}
+}; // end execution_config
+
+namespace detail
+{
+
+// the configuration installed by the innermost scoped_execution_config on
+// the calling thread, or null when the defaults are in effect
+inline const execution_config *&current_execution_config_ptr(void)
+{
+  static const execution_config *ptr = 0;
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#pragma omp threadprivate(ptr)
+#endif // omp support
+  return ptr;
+} // end current_execution_config_ptr()
+
+} // end namespace detail
+
+/*! \return The execution configuration in effect on the calling thread.
+ */
+inline execution_config current_execution_config(void)
+{
+  const execution_config *ptr = detail::current_execution_config_ptr();
+  return ptr ? *ptr : execution_config();
+} // end current_execution_config()
+
+/*! \p scoped_execution_config installs an \p execution_config for the calling
+ *  thread for the lifetime of the object, and restores the previous
+ *  configuration upon destruction.  Scopes may be nested.  Other threads and
+ *  the global OpenMP state (e.g. \c omp_set_num_threads) are unaffected.
+ *
+ *  The following code snippet demonstrates how to reduce a small array
+ *  without starting a parallel region, and a large one with two threads.
+ *
+ *  \code
+ *  #include <thrust/reduce.h>
+ *  #include <thrust/device_vector.h>
+ *  #include <thrust/execution_config.h>
+ *  ...
+ *  using namespace thrust::omp;
+ *
+ *  execution_config config;
+ *  config.num_threads   = 2;
+ *  config.serial_cutoff = 10000;
+ *
+ *  {
+ *    scoped_execution_config scope(config);
+ *
+ *    thrust::device_vector<int> small(100, 1);
+ *    thrust::reduce(small.begin(), small.end());  // serial
+ *
+ *    thrust::device_vector<int> large(1 << 20, 1);
+ *    thrust::reduce(large.begin(), large.end());  // two threads
+ *  }
+ *  \endcode
+ */
+class scoped_execution_config
+{
+  public:
+    explicit scoped_execution_config(const execution_config &config)
+      : m_config(config),
+        m_previous(detail::current_execution_config_ptr())
+    {
+      detail::current_execution_config_ptr() = &m_config;
+    }
+
+    ~scoped_execution_config(void)
+    {
+      detail::current_execution_config_ptr() = m_previous;
+    }
+
+  private:
+    execution_config m_config;
+    const execution_config *m_previous;
+
+    // noncopyable
+    scoped_execution_config(const scoped_execution_config &);
+    scoped_execution_config &operator=(const scoped_execution_config &);
+}; // end scoped_execution_config
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,445 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file extrema.inl
+ *  \brief Inline file for extrema.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/generic/extrema.h>
+#include <thrust/detail/device/omp/find.h>
+#include <thrust/detail/device/omp/reduce.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// The generic extrema reduce (value, index) pairs, which carries the index
+// through every comparison and defeats vectorization.  For arithmetic types
+// over trivial iterators the input is instead divided into small blocks,
+// which the threads reduce to their extreme values alone, with the
+// independent accumulators of reduce_block.  The first block whose extreme
+// value is equivalent to the overall one holds the first occurrence, which
+// find_if then locates within that block only.  So the input is read once,
+// plus the one block searched by find_if.
+
+// orders values so that the largest comes first
+template <typename BinaryPredicate>
+struct reverse_ordering
+{
+    BinaryPredicate comp;
+
+    reverse_ordering(BinaryPredicate comp) : comp(comp) {}
+
+    template <typename T>
+    bool operator()(const T& lhs, const T& rhs) const
+    {
+        return comp(rhs, lhs);
+    }
+}; // end reverse_ordering
+
+// the first of two values in the order given by comp, or lhs when they are
+// equivalent
+template <typename T,
+          typename BinaryPredicate>
+struct select_first
+{
+    BinaryPredicate comp;
+
+    select_first(BinaryPredicate comp) : comp(comp) {}
+
+    T operator()(const T& lhs, const T& rhs) const
+    {
+        return comp(rhs, lhs) ? rhs : lhs;
+    }
+}; // end select_first
+
+template <typename T,
+          typename BinaryPredicate>
+struct is_equivalent_to
+{
+    T value;
+    BinaryPredicate comp;
+
+    is_equivalent_to(const T& value, BinaryPredicate comp) : value(value), comp(comp) {}
+
+    bool operator()(const T& x) const
+    {
+        return !comp(x, value) && !comp(value, x);
+    }
+}; // end is_equivalent_to
+
+// the largest number of elements in a block of the vectorized extrema
+static const unsigned int extrema_block_size = 1 << 14;
+
+// reduces [first, first + n) to its first and last values in the order
+// given by comp, using independent accumulators as reduce_block does
+template <typename T,
+          typename BinaryPredicate>
+void minmax_block(const T * first,
+                  size_t n,
+                  BinaryPredicate comp,
+                  T& min_value,
+                  T& max_value)
+{
+    const size_t num_accumulators = 8;
+
+    select_first<T,BinaryPredicate>                   select_min(comp);
+    select_first<T,reverse_ordering<BinaryPredicate> > select_max(comp);
+
+    size_t i = 0;
+
+    min_value = max_value = first[i++];
+
+    if (n >= 2 * num_accumulators)
+    {
+        T min_accumulators[num_accumulators];
+        T max_accumulators[num_accumulators];
+
+        for (size_t k = 0; k < num_accumulators; k++)
+            min_accumulators[k] = max_accumulators[k] = first[k];
+
+        for (i = num_accumulators; i + num_accumulators <= n; i += num_accumulators)
+        {
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE) && (_OPENMP >= 201307)
+#           pragma omp simd
+#endif // omp simd support
+            for (size_t k = 0; k < num_accumulators; k++)
+            {
+                min_accumulators[k] = select_min(min_accumulators[k], first[i + k]);
+                max_accumulators[k] = select_max(max_accumulators[k], first[i + k]);
+            }
+        }
+
+        // combine the accumulators pairwise
+        for (size_t width = num_accumulators / 2; width > 0; width /= 2)
+        {
+            for (size_t k = 0; k < width; k++)
+            {
+                min_accumulators[k] = select_min(min_accumulators[k], min_accumulators[k + width]);
+                max_accumulators[k] = select_max(max_accumulators[k], max_accumulators[k + width]);
+            }
+        }
+
+        min_value = min_accumulators[0];
+        max_value = max_accumulators[0];
+    }
+
+    for (; i < n; i++)
+    {
+        min_value = select_min(min_value, first[i]);
+        max_value = select_max(max_value, first[i]);
+    }
+}
+
+// reduces block i of a raw array to results[2 * i] and results[2 * i + 1]
+template <typename T,
+          typename Size,
+          typename BinaryPredicate>
+struct minmax_raw_block_functor
+{
+    const T * data;
+    T * results;
+    Size n, block_size;
+    BinaryPredicate comp;
+
+    minmax_raw_block_functor(const T * data, T * results,
+                             Size n, Size block_size,
+                             BinaryPredicate comp)
+      : data(data), results(results), n(n), block_size(block_size), comp(comp) {}
+
+    void operator()(Size block)
+    {
+        Size begin = block * block_size;
+        Size end   = std::min<Size>(begin + block_size, n);
+
+        minmax_block(data + begin, end - begin, comp, results[2 * block], results[2 * block + 1]);
+    }
+}; // end minmax_raw_block_functor
+
+// the blocks of the vectorized extrema.  they are small, so that locating
+// the extremum within its block is cheap, and their results are packed
+// together, since each block writes them only once
+template <typename Size>
+struct extrema_blocks
+{
+    execution_config config;
+    Size num_threads, num_blocks, block_size;
+
+    extrema_blocks(Size n)
+      : config(current_execution_config())
+    {
+        num_threads = (n < Size(serial_reduce_threshold)) ? Size(1) : Size(choose_num_threads(n, config));
+        block_size  = std::min<Size>(extrema_block_size, (n + num_threads - 1) / num_threads);
+        num_blocks  = (n + block_size - 1) / block_size;
+    }
+}; // end extrema_blocks
+
+// the first block whose result, found at results[block * stride], is first
+// in the order given by comp
+template <typename T,
+          typename Size,
+          typename BinaryPredicate>
+Size first_extremal_block(const T * results, Size num_blocks, Size stride, BinaryPredicate comp)
+{
+    Size extremal_block = 0;
+
+    for (Size block = 1; block < num_blocks; block++)
+        if (comp(results[block * stride], results[extremal_block * stride]))
+            extremal_block = block;
+
+    return extremal_block;
+}
+
+// the first element of block equivalent to value
+template <typename RandomAccessIterator,
+          typename T,
+          typename Size,
+          typename BinaryPredicate>
+RandomAccessIterator locate_in_block(RandomAccessIterator first,
+                                     Size n,
+                                     Size block,
+                                     Size block_size,
+                                     const T& value,
+                                     BinaryPredicate comp)
+{
+    Size begin = block * block_size;
+    Size end   = std::min<Size>(begin + block_size, n);
+
+    return thrust::detail::device::omp::find_if(first + begin, first + end,
+                                                is_equivalent_to<T,BinaryPredicate>(value, comp));
+}
+
+// OpenMP path for min_element with arithmetic types over trivial iterators
+template <typename ForwardIterator,
+          typename BinaryPredicate>
+ForwardIterator min_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp,
+                            thrust::detail::true_type)
+{
+    typedef typename thrust::iterator_value<ForwardIterator>::type      T;
+    typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+    difference_type n = last - first;
+
+    // ForwardIterator is trivial, so work with raw pointers
+    const T * data = thrust::raw_pointer_cast(&*first);
+
+    extrema_blocks<difference_type> blocks(n);
+
+    thrust::detail::raw_omp_device_buffer<T> block_results(blocks.num_blocks);
+
+    T * results = thrust::raw_pointer_cast(&*block_results.begin());
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#   pragma omp parallel num_threads(std::min(blocks.num_threads, blocks.num_blocks)) if (blocks.num_threads > 1)
+    worksharing_for(blocks.num_blocks,
+                    reduce_raw_block_functor<T,T,difference_type,select_first<T,BinaryPredicate> >
+                      (data, results, n, blocks.block_size, difference_type(1), select_first<T,BinaryPredicate>(comp)),
+                    blocks.config.schedule, difference_type(1));
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    difference_type block = first_extremal_block(results, blocks.num_blocks, difference_type(1), comp);
+
+    return locate_in_block(first, n, block, blocks.block_size, results[block], comp);
+}
+
+// OpenMP path for max_element with arithmetic types over trivial iterators
+template <typename ForwardIterator,
+          typename BinaryPredicate>
+ForwardIterator max_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp,
+                            thrust::detail::true_type)
+{
+    // the first largest element is the first smallest in the reverse order
+    return thrust::detail::device::omp::detail::min_element(first, last, reverse_ordering<BinaryPredicate>(comp), thrust::detail::true_type());
+}
+
+// OpenMP path for minmax_element with arithmetic types over trivial iterators
+template <typename ForwardIterator,
+          typename BinaryPredicate>
+thrust::pair<ForwardIterator,ForwardIterator> minmax_element(ForwardIterator first,
+                                                             ForwardIterator last,
+                                                             BinaryPredicate comp,
+                                                             thrust::detail::true_type)
+{
+    typedef typename thrust::iterator_value<ForwardIterator>::type      T;
+    typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+    difference_type n = last - first;
+
+    // ForwardIterator is trivial, so work with raw pointers
+    const T * data = thrust::raw_pointer_cast(&*first);
+
+    extrema_blocks<difference_type> blocks(n);
+
+    // the smallest and largest values of block i are results[2 * i] and results[2 * i + 1]
+    thrust::detail::raw_omp_device_buffer<T> block_results(2 * blocks.num_blocks);
+
+    T * results = thrust::raw_pointer_cast(&*block_results.begin());
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#   pragma omp parallel num_threads(std::min(blocks.num_threads, blocks.num_blocks)) if (blocks.num_threads > 1)
+    worksharing_for(blocks.num_blocks,
+                    minmax_raw_block_functor<T,difference_type,BinaryPredicate>
+                      (data, results, n, blocks.block_size, comp),
+                    blocks.config.schedule, difference_type(1));
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    reverse_ordering<BinaryPredicate> reverse_comp(comp);
+
+    difference_type min_block = first_extremal_block(results,     blocks.num_blocks, difference_type(2), comp);
+    difference_type max_block = first_extremal_block(results + 1, blocks.num_blocks, difference_type(2), reverse_comp);
+
+    return thrust::make_pair(locate_in_block(first, n, min_block, blocks.block_size, results[2 * min_block],     comp),
+                             locate_in_block(first, n, max_block, blocks.block_size, results[2 * max_block + 1], reverse_comp));
+}
+
+// OpenMP path for the extrema of general types and iterators
+template <typename ForwardIterator,
+          typename BinaryPredicate>
+ForwardIterator min_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp,
+                            thrust::detail::false_type)
+{
+    return thrust::detail::device::generic::min_element(first, last, comp);
+}
+
+template <typename ForwardIterator,
+          typename BinaryPredicate>
+ForwardIterator max_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp,
+                            thrust::detail::false_type)
+{
+    return thrust::detail::device::generic::max_element(first, last, comp);
+}
+
+template <typename ForwardIterator,
+          typename BinaryPredicate>
+thrust::pair<ForwardIterator,ForwardIterator> minmax_element(ForwardIterator first,
+                                                             ForwardIterator last,
+                                                             BinaryPredicate comp,
+                                                             thrust::detail::false_type)
+{
+    return thrust::detail::device::generic::minmax_element(first, last, comp);
+}
+
+template <typename ForwardIterator>
+  struct use_vectorized_extrema
+    : thrust::detail::integral_constant<
+        bool,
+        thrust::detail::is_trivial_iterator<ForwardIterator>::value &&
+        thrust::detail::is_arithmetic<typename thrust::iterator_value<ForwardIterator>::type>::value
+      >
+{};
+
+} // end namespace detail
+
+template <typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator min_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<ForwardIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    if (first == last)
+        return last;
+
+    return thrust::detail::device::omp::detail::min_element(first, last, comp,
+        thrust::detail::device::omp::detail::use_vectorized_extrema<ForwardIterator>());
+}
+
+template <typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator max_element(ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<ForwardIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    if (first == last)
+        return last;
+
+    return thrust::detail::device::omp::detail::max_element(first, last, comp,
+        thrust::detail::device::omp::detail::use_vectorized_extrema<ForwardIterator>());
+}
+
+template <typename ForwardIterator, typename BinaryPredicate>
+thrust::pair<ForwardIterator,ForwardIterator> minmax_element(ForwardIterator first,
+                                                             ForwardIterator last,
+                                                             BinaryPredicate comp)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<ForwardIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    if (first == last)
+        return thrust::make_pair(last, last);
+
+    return thrust::detail::device::omp::detail::minmax_element(first, last, comp,
+        thrust::detail::device::omp::detail::use_vectorized_extrema<ForwardIterator>());
+}
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
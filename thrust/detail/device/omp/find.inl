@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file find.inl
+ *  \brief Inline file for find.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+// The input is split into small blocks which are dealt to the threads
+// round-robin, so every thread starts near the front of the sequence.
+// The smallest index found so far is shared by all threads.  A thread
+// stops at its first match and skips any block beginning past the
+// shared index, so a match near the front ends the search early.
+
+template <typename InputIterator,
+          typename Predicate>
+InputIterator find_if(InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+    if (first == last)
+        return last;
+
+    difference_type n = last - first;
+
+    // the index of the first match found so far, or n
+    difference_type result = n;
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    const difference_type block_size = 1 << 12;
+
+    difference_type num_blocks = (n + block_size - 1) / block_size;
+
+    int P = std::min<difference_type>(thrust::detail::device::omp::detail::choose_num_threads(n), num_blocks);
+
+#   pragma omp parallel num_threads(P) if (P > 1)
+    {
+        difference_type num_threads = omp_get_num_threads();
+        difference_type p_i         = omp_get_thread_num();
+
+        for (difference_type block = p_i; block < num_blocks; block += num_threads)
+        {
+            difference_type begin = block * block_size;
+            difference_type end   = std::min<difference_type>(begin + block_size, n);
+
+            difference_type found;
+
+#if (_OPENMP >= 201107)
+#           pragma omp atomic read
+#else
+#           pragma omp flush(result)
+#endif // omp atomic read support
+            found = result;
+
+            // an earlier match exists, so this block and all later ones are irrelevant
+            if (found <= begin)
+                break;
+
+            InputIterator iter = first + begin;
+
+            for (; begin != end; ++begin, ++iter)
+                if (pred(thrust::detail::device::dereference(iter)))
+                    break;
+
+            if (begin != end)
+            {
+                // result is read atomically outside the critical section,
+                // so it must also be written atomically
+#               pragma omp critical (thrust_omp_find_if)
+                {
+                    if (begin < result)
+                    {
+#if (_OPENMP >= 201107)
+#                       pragma omp atomic write
+#endif // omp atomic write support
+                        result = begin;
+                    }
+                }
+
+                // the remaining blocks of this thread lie past this match
+                break;
+            }
+        }
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return first + result;
+}
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
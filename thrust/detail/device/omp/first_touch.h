@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file first_touch.h
+ *  \brief Places the pages of newly allocated storage near the
+ *         threads which will process them.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+namespace device
+{
+
+namespace omp
+{
+
+
+/*! \p first_touch writes to each page of the uninitialized storage
+ *  <tt>[first, first + n)</tt> from the thread which a static schedule over
+ *  \p n elements assigns to that page.  Under a first-touch NUMA policy,
+ *  each page is then placed on the node of the thread which will later
+ *  process its elements.
+ *
+ *  Pages which were touched before (e.g. storage recycled by \c malloc)
+ *  keep their placement.
+ */
+template<typename RandomAccessIterator,
+         typename Size>
+void first_touch(RandomAccessIterator first,
+                 Size n);
+
+
+} // end namespace omp
+
+} // end namespace device
+
+} // end namespace detail
+
+} // end namespace thrust
+
+#include <thrust/detail/device/omp/first_touch.inl>
+
@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file first_touch.inl
+ *  \brief Inline file for first_touch.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/device_ptr.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+#include <cstddef>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// the granularity of NUMA placement.  when the system uses larger pages,
+// each page is placed by the first thread to touch any of it
+const std::size_t first_touch_page_size = 4096;
+
+// writes one byte of page first_page + i which lies in [begin, end)
+struct first_touch_functor
+{
+  char *begin;
+  std::size_t first_page;
+
+  first_touch_functor(char *begin, std::size_t first_page)
+    : begin(begin), first_page(first_page) {}
+
+  template<typename Size>
+  void operator()(Size i)
+  {
+    char *page = reinterpret_cast<char*>((first_page + i) * first_touch_page_size);
+
+    // the first page may begin before the storage
+    volatile char *ptr = page < begin ? begin : page;
+
+    *ptr = 0;
+  }
+}; // end first_touch_functor
+
+} // end namespace detail
+
+template<typename RandomAccessIterator,
+         typename Size>
+void first_touch(RandomAccessIterator first,
+                 Size n)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  // use the team which for_each would use to process n elements
+  int P = detail::choose_num_threads(n);
+
+  // a single thread touches the storage when it initializes it
+  if (P < 2)
+    return;
+
+  char *begin = reinterpret_cast<char*>(thrust::raw_pointer_cast(&*first));
+  char *end   = begin + static_cast<std::size_t>(n) * sizeof(value_type);
+
+  std::size_t first_page = reinterpret_cast<std::size_t>(begin) / detail::first_touch_page_size;
+  std::size_t last_page  = reinterpret_cast<std::size_t>(end - 1) / detail::first_touch_page_size;
+  std::size_t num_pages  = last_page - first_page + 1;
+
+  // with fewer pages than threads, placement hardly matters
+  if (num_pages < static_cast<std::size_t>(P))
+    return;
+
+  // the static schedule of the pages approximates the static schedule
+  // of the elements they contain
+#pragma omp parallel num_threads(P)
+  detail::worksharing_for(num_pages, detail::first_touch_functor(begin, first_page), static_schedule, std::size_t(1));
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end first_touch()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -24,6 +24,7 @@
 #include <thrust/detail/device/dereference.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
 
 namespace thrust
 {
@@ -33,6 +34,28 @@ namespace device
 {
 namespace omp
 {
+namespace detail
+{
+
+template<typename InputIterator,
+         typename UnaryFunction>
+struct for_each_functor
+{
+  InputIterator first;
+  UnaryFunction f;
+
+  for_each_functor(InputIterator first, UnaryFunction f)
+    : first(first), f(f) {}
+
+  template<typename Size>
+  void operator()(Size i)
+  {
+    InputIterator temp = first + i;
+    f(thrust::detail::device::dereference(temp));
+  }
+}; // end for_each_functor
+
+} // end namespace detail
 
 template<typename InputIterator,
          typename UnaryFunction>
@@ -51,19 +74,9 @@ void for_each(InputIterator first,
   typedef typename thrust::iterator_difference<InputIterator>::type difference;
   difference n = thrust::distance(first,last);
 
-// do not attempt to compile the body of this function, which depends on #pragma omp,
-// without support from the compiler
-// XXX implement the body of this function in another file to eliminate this ugliness
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-#pragma omp parallel for
-  for(difference i = 0;
-      i < n;
-      ++i)
-  {
-    InputIterator temp = first + i;
-    f(dereference(temp));
-  }
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  // parallelize according to the current execution_config
+  thrust::detail::device::omp::detail::parallel_for
+    (n, detail::for_each_functor<InputIterator,UnaryFunction>(first, f));
 } 
 
 
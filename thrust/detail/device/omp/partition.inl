@@ -0,0 +1,237 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file partition.inl
+ *  \brief Inline file for partition.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+template<typename RandomAccessIterator,
+         typename Size>
+void swap_elements(RandomAccessIterator first, Size i, Size j)
+{
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type T;
+
+    T temp = thrust::detail::device::dereference(first, i);
+    thrust::detail::device::dereference(first, i) = thrust::detail::device::dereference(first, j);
+    thrust::detail::device::dereference(first, j) = temp;
+}
+
+template<typename RandomAccessIterator,
+         typename Size>
+void reverse(RandomAccessIterator first, Size begin, Size end)
+{
+    for (; begin + 1 < end; ++begin, --end)
+        swap_elements(first, begin, end - 1);
+}
+
+// exchanges [begin, middle) and [middle, end)
+template<typename RandomAccessIterator,
+         typename Size>
+void rotate(RandomAccessIterator first, Size begin, Size middle, Size end)
+{
+    if (begin == middle || middle == end)
+        return;
+
+    reverse(first, begin, middle);
+    reverse(first, middle, end);
+    reverse(first, begin, end);
+}
+
+// as reverse, divided among the threads of the team,
+// every thread of which must call this function
+template<typename RandomAccessIterator,
+         typename Size>
+void reverse(RandomAccessIterator first, Size begin, Size end, int num_threads, int p_i)
+{
+    Size half  = (end - begin) / 2;
+    Size chunk = (half + num_threads - 1) / num_threads;
+    Size i     = std::min<Size>(chunk * p_i, half);
+    Size last  = std::min<Size>(chunk * (p_i + 1), half);
+
+    for (; i < last; i++)
+        swap_elements(first, begin + i, end - 1 - i);
+
+#   pragma omp barrier
+}
+
+// as rotate, divided among the threads of the team,
+// every thread of which must call this function
+template<typename RandomAccessIterator,
+         typename Size>
+void rotate(RandomAccessIterator first, Size begin, Size middle, Size end, int num_threads, int p_i)
+{
+    const Size min_elements_per_thread = 1 << 12;
+
+    // a single thread handles the short (or empty) rotations, and the
+    // implicit barrier of single keeps the team together either way
+    if (begin == middle || middle == end || end - begin < min_elements_per_thread * num_threads)
+    {
+#       pragma omp single
+        rotate(first, begin, middle, end);
+    }
+    else
+    {
+        reverse(first, begin, middle, num_threads, p_i);
+        reverse(first, middle, end, num_threads, p_i);
+        reverse(first, begin, end, num_threads, p_i);
+    }
+}
+
+// Stably partitions [first + begin, first + end) without a temporary by
+// partitioning each half and rotating the false elements of the first half
+// past the true elements of the second.  Returns the number of true elements.
+template<typename RandomAccessIterator,
+         typename Size,
+         typename Predicate>
+Size stable_partition_in_place(RandomAccessIterator first, Size begin, Size end, Predicate pred)
+{
+    Size num_true = 0;
+
+    // a leading run of true elements is already in place
+    while (begin != end && pred(thrust::detail::device::dereference(first, begin)))
+    {
+        ++begin;
+        ++num_true;
+    }
+
+    // nothing, or a single false element, remains
+    if (end - begin < 2)
+        return num_true;
+
+    Size middle = begin + (end - begin) / 2;
+
+    Size num_true_left  = stable_partition_in_place(first, begin, middle, pred);
+    Size num_true_right = stable_partition_in_place(first, middle, end, pred);
+
+    rotate(first, begin + num_true_left, middle, middle + num_true_right);
+
+    return num_true + num_true_left + num_true_right;
+}
+
+} // end namespace detail
+
+
+// Each thread stably partitions its block in place.  Neighboring groups of
+// blocks are then merged pairwise by rotating the false elements of the
+// left group past the true elements of the right group, which the whole
+// team performs together.  Only the number of true elements of each group
+// is stored, so no copy of the input is made, at the price of moving each
+// element O(log n) times rather than twice.
+
+template<typename ForwardIterator,
+         typename Predicate>
+  ForwardIterator stable_partition(ForwardIterator first,
+                                   ForwardIterator last,
+                                   Predicate pred)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<ForwardIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+    difference_type n = last - first;
+
+    if (n == 0)
+        return first;
+
+    difference_type result = 0;
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    int P = thrust::detail::device::omp::detail::choose_num_threads(n);
+
+    // num_true[i] is the number of true elements of the group beginning with block i
+    thrust::detail::raw_omp_device_buffer<difference_type> num_true_buffer(P);
+    difference_type * num_true = thrust::raw_pointer_cast(&*num_true_buffer.begin());
+
+    #pragma omp parallel num_threads(P) if (P > 1)
+    {
+        // the runtime may provide fewer threads than requested
+        int num_threads = omp_get_num_threads();
+        int p_i         = omp_get_thread_num();
+
+        difference_type block_size = (n + num_threads - 1) / num_threads;
+        difference_type begin      = std::min<difference_type>(block_size * p_i, n);
+        difference_type end        = std::min<difference_type>(begin + block_size, n);
+
+        num_true[p_i] = thrust::detail::device::omp::detail::stable_partition_in_place(first, begin, end, pred);
+
+        #pragma omp barrier
+
+        for (int width = 1; width < num_threads; width *= 2)
+        {
+            for (int group = 0; group + width < num_threads; group += 2 * width)
+            {
+                difference_type left  = std::min<difference_type>(block_size * group, n);
+                difference_type right = std::min<difference_type>(block_size * (group + width), n);
+
+                thrust::detail::device::omp::detail::rotate(first,
+                                                            left + num_true[group],
+                                                            right,
+                                                            right + num_true[group + width],
+                                                            num_threads, p_i);
+
+                #pragma omp single
+                num_true[group] += num_true[group + width];
+            }
+        }
+
+        #pragma omp single
+        result = num_true[0];
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return first + result;
+}
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
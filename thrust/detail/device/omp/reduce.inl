@@ -20,9 +20,15 @@
 #endif // omp support
 
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/device_ptr.h>
 #include <thrust/distance.h>
 #include <thrust/detail/raw_buffer.h>
 #include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/deterministic.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+#include <algorithm>
 
 namespace thrust
 {
@@ -32,61 +38,225 @@ namespace device
 {
 namespace omp
 {
+namespace detail
+{
+
+// inputs shorter than this are reduced without starting a parallel region
+static const unsigned int serial_reduce_threshold = 1 << 15;
+
+// the partial result of each block is written to its own cache line
+static const unsigned int cache_line_size = 64;
+
+// reduces [first, first + n) using several independent accumulators, which
+// breaks the dependence between consecutive applications of binary_op and
+// lets the compiler keep the accumulators in the lanes of a vector register.
+// the accumulators are assigned by position within the block, so the result
+// depends only on the block and not on the alignment of first
+template <typename OutputType,
+          typename InputType,
+          typename BinaryFunction>
+OutputType reduce_block(const InputType * first,
+                        size_t n,
+                        BinaryFunction binary_op)
+{
+    const size_t num_accumulators = 8;
+
+    size_t i = 0;
+
+    OutputType sum = first[i++];
+
+    if (n >= 2 * num_accumulators)
+    {
+        OutputType accumulators[num_accumulators];
+
+        for (size_t k = 0; k < num_accumulators; k++)
+            accumulators[k] = first[k];
+
+        for (i = num_accumulators; i + num_accumulators <= n; i += num_accumulators)
+        {
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE) && (_OPENMP >= 201307)
+#           pragma omp simd
+#endif // omp simd support
+            for (size_t k = 0; k < num_accumulators; k++)
+                accumulators[k] = binary_op(accumulators[k], first[i + k]);
+        }
+
+        // combine the accumulators pairwise
+        for (size_t width = num_accumulators / 2; width > 0; width /= 2)
+            for (size_t k = 0; k < width; k++)
+                accumulators[k] = binary_op(accumulators[k], accumulators[k + width]);
+
+        sum = accumulators[0];
+    }
+
+    for (; i < n; i++)
+        sum = binary_op(sum, first[i]);
+
+    return sum;
+}
+
+// reduces block i of a raw array to results[i * stride]
+template <typename InputType,
+          typename OutputType,
+          typename Size,
+          typename BinaryFunction>
+struct reduce_raw_block_functor
+{
+    const InputType * data;
+    OutputType * results;
+    Size n, block_size, stride;
+    BinaryFunction binary_op;
+
+    reduce_raw_block_functor(const InputType * data, OutputType * results,
+                             Size n, Size block_size, Size stride,
+                             BinaryFunction binary_op)
+      : data(data), results(results), n(n), block_size(block_size), stride(stride), binary_op(binary_op) {}
+
+    void operator()(Size block)
+    {
+        Size begin = block * block_size;
+        Size end   = std::min<Size>(begin + block_size, n);
 
+        results[block * stride] = reduce_block<OutputType>(data + begin, end - begin, binary_op);
+    }
+}; // end reduce_raw_block_functor
+
+// reduces block i of [first, first + n) to *(result + i)
+template <typename InputIterator,
+          typename OutputIterator,
+          typename Size,
+          typename BinaryFunction>
+struct reduce_block_functor
+{
+    typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
+
+    InputIterator first;
+    OutputIterator result;
+    Size n, block_size;
+    BinaryFunction binary_op;
+
+    reduce_block_functor(InputIterator first, OutputIterator result,
+                         Size n, Size block_size,
+                         BinaryFunction binary_op)
+      : first(first), result(result), n(n), block_size(block_size), binary_op(binary_op) {}
+
+    void operator()(Size block)
+    {
+        InputIterator iter = first + block * block_size;
+        InputIterator end  = first + std::min<Size>((block + 1) * block_size, n);
+
+        OutputType block_sum = thrust::detail::device::dereference(iter);
+
+        for (++iter; iter != end; ++iter)
+            block_sum = binary_op(block_sum, thrust::detail::device::dereference(iter));
+
+        thrust::detail::device::dereference(result, block) = block_sum;
+    }
+}; // end reduce_block_functor
+
+// OpenMP path for thrust::reduce with arithmetic types over
+// trivial iterators (e.g. raw pointers and device_vector iterators)
 template <typename InputIterator,
           typename OutputType,
           typename BinaryFunction>
 OutputType reduce(InputIterator first,
                   InputIterator last,
                   OutputType init,
-                  BinaryFunction binary_op)
+                  BinaryFunction binary_op,
+                  thrust::detail::true_type)
 {
-    // we're attempting to launch an omp kernel, assert we're compiling with omp support
-    // ========================================================================
-    // X Note to the user: If you've found this line due to a compiler error, X
-    // X you need to OpenMP support in your compiler.                         X
-    // ========================================================================
-    THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
-                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
-
+    typedef typename thrust::iterator_value<InputIterator>::type      InputType;
     typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
 
-    if (first == last)
-        return init;
+    difference_type N = last - first;
 
-    difference_type N = thrust::distance(first, last);
+    // InputIterator is trivial, so work with raw pointers
+    const InputType * data = thrust::raw_pointer_cast(&*first);
 
 // do not attempt to compile the body of this function, which calls omp functions, without
 // support from the compiler
 // XXX implement the body of this function in another file to eliminate this ugliness
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-    int num_threads = std::min<difference_type>(omp_get_max_threads(), N);
+    execution_config config = current_execution_config();
 
-    thrust::detail::raw_omp_device_buffer<OutputType> thread_results(first, first + num_threads);
+    difference_type num_threads = (N < difference_type(serial_reduce_threshold)) ?
+                                  difference_type(1) :
+                                  difference_type(choose_num_threads(N, config));
 
-#   pragma omp parallel num_threads(num_threads)
-    {
+    // the blocks are chosen exactly as in the general path below, so
+    // deterministic mode is also honored when the input is reduced serially
+    difference_type num_blocks = omp::detail::reduction_num_blocks(N, num_threads);
+    difference_type block_size = (N + num_blocks - 1) / num_blocks;
+    num_blocks = (N + block_size - 1) / block_size;
 
-        int thread_id = omp_get_thread_num();
+    const difference_type stride = (cache_line_size + sizeof(OutputType) - 1) / sizeof(OutputType);
 
-        OutputType thread_sum = thread_results[thread_id];
+    thrust::detail::raw_omp_device_buffer<OutputType> block_results(num_blocks * stride);
 
-#      pragma omp for 
-        for (difference_type i = num_threads; i < N; i++)
-        {
-            InputIterator temp = first + i;
-            thread_sum = binary_op(thread_sum, thrust::detail::device::dereference(temp));
-        }
+    OutputType * results = thrust::raw_pointer_cast(&*block_results.begin());
 
-        thread_results[thread_id] = thread_sum;
-    }
+#   pragma omp parallel num_threads(std::min(num_threads, num_blocks)) if (num_threads > 1)
+    worksharing_for(num_blocks,
+                    reduce_raw_block_functor<InputType,OutputType,difference_type,BinaryFunction>
+                      (data, results, N, block_size, stride, binary_op),
+                    config.schedule, difference_type(1));
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 
     OutputType total_sum = init;
 
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-    for (typename thrust::detail::raw_omp_device_buffer<OutputType>::iterator result = thread_results.begin();
-         result != thread_results.end();
+    for (difference_type block = 0; block < num_blocks; block++)
+        total_sum = binary_op(total_sum, results[block * stride]);
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return total_sum;
+}
+
+// OpenMP path for thrust::reduce with general types and iterators
+template <typename InputIterator,
+          typename OutputType,
+          typename BinaryFunction>
+OutputType reduce(InputIterator first,
+                  InputIterator last,
+                  OutputType init,
+                  BinaryFunction binary_op,
+                  thrust::detail::false_type)
+{
+    typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+    difference_type N = thrust::distance(first, last);
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    execution_config config = current_execution_config();
+
+    difference_type num_threads = choose_num_threads(N, config);
+
+    // split the input into contiguous blocks and reduce each block in parallel.
+    // in deterministic mode the blocks depend only on N and the block results
+    // are combined left to right, so the result is independent of the team size
+    difference_type num_blocks = omp::detail::reduction_num_blocks(N, num_threads);
+    difference_type block_size = (N + num_blocks - 1) / num_blocks;
+    num_blocks = (N + block_size - 1) / block_size;
+
+    thrust::detail::raw_omp_device_buffer<OutputType> block_results(num_blocks);
+
+    typedef typename thrust::detail::raw_omp_device_buffer<OutputType>::iterator BufferIterator;
+
+#   pragma omp parallel num_threads(std::min(num_threads, num_blocks)) if (num_threads > 1)
+    worksharing_for(num_blocks,
+                    reduce_block_functor<InputIterator,BufferIterator,difference_type,BinaryFunction>
+                      (first, block_results.begin(), N, block_size, binary_op),
+                    config.schedule, difference_type(1));
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    OutputType total_sum = init;
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    for (typename thrust::detail::raw_omp_device_buffer<OutputType>::iterator result = block_results.begin();
+         result != block_results.end();
          ++result)
         total_sum = binary_op(total_sum, thrust::detail::device::dereference(result));
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
@@ -94,6 +264,42 @@ OutputType reduce(InputIterator first,
     return total_sum;
 }
 
+template <typename InputIterator,
+          typename OutputType>
+  struct use_arithmetic_reduce
+    : thrust::detail::integral_constant<
+        bool,
+        thrust::detail::is_trivial_iterator<InputIterator>::value &&
+        thrust::detail::is_arithmetic<typename thrust::iterator_value<InputIterator>::type>::value &&
+        thrust::detail::is_arithmetic<OutputType>::value
+      >
+{};
+
+} // end namespace detail
+
+template <typename InputIterator,
+          typename OutputType,
+          typename BinaryFunction>
+OutputType reduce(InputIterator first,
+                  InputIterator last,
+                  OutputType init,
+                  BinaryFunction binary_op)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    if (first == last)
+        return init;
+
+    return thrust::detail::device::omp::detail::reduce(first, last, init, binary_op,
+        thrust::detail::device::omp::detail::use_arithmetic_reduce<InputIterator,OutputType>());
+}
+
 } // end namespace omp
 } // end namespace device
 } // end namespace detail
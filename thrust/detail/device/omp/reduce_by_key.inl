@@ -0,0 +1,218 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file reduce_by_key.inl
+ *  \brief Inline file for reduce_by_key.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+/*
+ *  The input is split into one block per thread.  In a first pass, every
+ *  thread counts the segment heads in its block and reduces the values of
+ *  the block's last (possibly incomplete) segment.  A serial pass over the
+ *  blocks then computes where each block's segments begin in the output and
+ *  the partial reduction carried into each block by a segment that begins
+ *  in an earlier block.  In a second pass, every thread reduces its block
+ *  and writes each segment whose last element lies in the block.  Only
+ *  O(threads) temporary storage is needed.
+ */
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key(InputIterator1 keys_first, 
+                InputIterator1 keys_last,
+                InputIterator2 values_first,
+                OutputIterator1 keys_output,
+                OutputIterator2 values_output,
+                BinaryPredicate binary_pred,
+                BinaryFunction binary_op)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator1,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+    typedef typename thrust::iterator_value<OutputIterator2>::type     ValueType;
+
+    difference_type n = keys_last - keys_first;
+
+    if (n == 0)
+        return thrust::make_pair(keys_output, values_output);
+
+    difference_type num_segments = 0;
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    int P = thrust::detail::device::omp::detail::choose_num_threads(n);
+
+    // offsets[i] is the number of segment heads preceding block i
+    thrust::detail::raw_omp_device_buffer<difference_type> offsets_buffer(P + 1);
+    difference_type * offsets = thrust::raw_pointer_cast(&*offsets_buffer.begin());
+
+    // carries[i] is the reduction of the last segment of block i, restricted to block i,
+    // which becomes the reduction carried into block i + 1 if that block doesn't begin a segment
+    thrust::detail::raw_omp_device_buffer<ValueType> carries(P);
+
+    #pragma omp parallel num_threads(P) if (P > 1)
+    {
+        // the runtime may provide fewer threads than requested
+        int num_threads = omp_get_num_threads();
+        int p_i         = omp_get_thread_num();
+
+        difference_type block_size = (n + num_threads - 1) / num_threads;
+        difference_type begin      = std::min<difference_type>(block_size * p_i, n);
+        difference_type end        = std::min<difference_type>(begin + block_size, n);
+
+        // count the segment heads in this block and find the last one
+        difference_type num_heads = 0;
+        difference_type last_head = begin;
+
+        for (difference_type i = begin; i < end; i++)
+        {
+            if (i == 0 || !binary_pred(thrust::detail::device::dereference(keys_first, i - 1),
+                                       thrust::detail::device::dereference(keys_first, i)))
+            {
+                ++num_heads;
+                last_head = i;
+            }
+        }
+
+        offsets[p_i + 1] = num_heads;
+
+        // reduce the last segment of this block
+        if (begin < end)
+        {
+            ValueType carry = thrust::detail::device::dereference(values_first, last_head);
+
+            for (difference_type i = last_head + 1; i < end; i++)
+                carry = binary_op(carry, thrust::detail::device::dereference(values_first, i));
+
+            thrust::detail::device::dereference(carries.begin(), p_i) = carry;
+        }
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            offsets[0] = 0;
+
+            for (int i = 0; i < num_threads; i++)
+            {
+                // a block without heads continues the segment carried into it
+                if (i > 0 && offsets[i + 1] == 0 && i * block_size < n)
+                {
+                    ValueType carry = thrust::detail::device::dereference(carries.begin(), i - 1);
+                    thrust::detail::device::dereference(carries.begin(), i) =
+                      binary_op(carry, ValueType(thrust::detail::device::dereference(carries.begin(), i)));
+                }
+
+                offsets[i + 1] += offsets[i];
+            }
+
+            num_segments = offsets[num_threads];
+        }
+
+        if (begin < end)
+        {
+            // the index of the segment containing element i
+            difference_type segment = offsets[p_i] - 1;
+
+            ValueType sum;
+
+            // continue the segment carried into this block, if any
+            if (begin > 0 && binary_pred(thrust::detail::device::dereference(keys_first, begin - 1),
+                                         thrust::detail::device::dereference(keys_first, begin)))
+            {
+                sum = thrust::detail::device::dereference(carries.begin(), p_i - 1);
+                sum = binary_op(sum, thrust::detail::device::dereference(values_first, begin));
+            }
+            else
+            {
+                ++segment;
+                thrust::detail::device::dereference(keys_output, segment) = thrust::detail::device::dereference(keys_first, begin);
+                sum = thrust::detail::device::dereference(values_first, begin);
+            }
+
+            for (difference_type i = begin + 1; i < end; i++)
+            {
+                if (binary_pred(thrust::detail::device::dereference(keys_first, i - 1),
+                                thrust::detail::device::dereference(keys_first, i)))
+                {
+                    sum = binary_op(sum, thrust::detail::device::dereference(values_first, i));
+                }
+                else
+                {
+                    // the previous segment ends at i - 1
+                    thrust::detail::device::dereference(values_output, segment) = sum;
+
+                    ++segment;
+                    thrust::detail::device::dereference(keys_output, segment) = thrust::detail::device::dereference(keys_first, i);
+                    sum = thrust::detail::device::dereference(values_first, i);
+                }
+            }
+
+            // write the last segment if it ends in this block
+            if (end == n || !binary_pred(thrust::detail::device::dereference(keys_first, end - 1),
+                                         thrust::detail::device::dereference(keys_first, end)))
+            {
+                thrust::detail::device::dereference(values_output, segment) = sum;
+            }
+        }
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return thrust::make_pair(keys_output + num_segments, values_output + num_segments);
+}
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
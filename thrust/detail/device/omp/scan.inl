@@ -14,8 +14,21 @@
  *  limitations under the License.
  */
 
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
 #include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/deterministic.h>
+#include <thrust/detail/device/omp/reduce.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+
+#include <algorithm>
 
 namespace thrust
 {
@@ -26,7 +39,99 @@ namespace device
 namespace omp
 {
 
-// TODO parallelize these
+// The scans below use a three phase blocked algorithm.  The input is split
+// into contiguous blocks, one per thread by default, or of a size fixed by n
+// alone in deterministic mode.  First, every block but the last is reduced
+// (upsweep).  Next, a single thread scans the block sums to produce each
+// block's carry-in.  Finally, every block is scanned starting from its
+// carry-in (downsweep).  Blocks are combined strictly left to right, so
+// binary_op need only be associative, not commutative.  Each input element
+// is read before its corresponding output is written, so the scans may be
+// performed in-place.
+
+namespace detail
+{
+
+// scans block i of [first, first + n) into result, starting from the
+// carry-out of block i - 1
+template<typename InputIterator,
+         typename OutputIterator,
+         typename BufferIterator,
+         typename Size,
+         typename AssociativeOperator>
+struct inclusive_downsweep_functor
+{
+    typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
+
+    InputIterator first;
+    OutputIterator result;
+    BufferIterator block_sums;
+    Size n, block_size;
+    AssociativeOperator binary_op;
+
+    inclusive_downsweep_functor(InputIterator first, OutputIterator result, BufferIterator block_sums,
+                                Size n, Size block_size, AssociativeOperator binary_op)
+      : first(first), result(result), block_sums(block_sums), n(n), block_size(block_size), binary_op(binary_op) {}
+
+    void operator()(Size block)
+    {
+        InputIterator  iter = first  + block * block_size;
+        InputIterator  end  = first  + std::min<Size>((block + 1) * block_size, n);
+        OutputIterator out  = result + block * block_size;
+
+        OutputType sum = thrust::detail::device::dereference(iter);
+
+        if (block > 0)
+            sum = binary_op(OutputType(thrust::detail::device::dereference(block_sums, block - 1)), sum);
+
+        thrust::detail::device::dereference(out) = sum;
+
+        for(++iter, ++out; iter != end; ++iter, ++out)
+            thrust::detail::device::dereference(out)
+              = sum = binary_op(sum, thrust::detail::device::dereference(iter));
+    }
+}; // end inclusive_downsweep_functor
+
+// scans block i of [first, first + n) into result, starting from the
+// carry-in of block i
+template<typename InputIterator,
+         typename OutputIterator,
+         typename BufferIterator,
+         typename Size,
+         typename AssociativeOperator>
+struct exclusive_downsweep_functor
+{
+    typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
+
+    InputIterator first;
+    OutputIterator result;
+    BufferIterator block_sums;
+    Size n, block_size;
+    AssociativeOperator binary_op;
+
+    exclusive_downsweep_functor(InputIterator first, OutputIterator result, BufferIterator block_sums,
+                                Size n, Size block_size, AssociativeOperator binary_op)
+      : first(first), result(result), block_sums(block_sums), n(n), block_size(block_size), binary_op(binary_op) {}
+
+    void operator()(Size block)
+    {
+        InputIterator  iter = first  + block * block_size;
+        InputIterator  end  = first  + std::min<Size>((block + 1) * block_size, n);
+        OutputIterator out  = result + block * block_size;
+
+        OutputType sum = thrust::detail::device::dereference(block_sums, block);
+
+        for(; iter != end; ++iter, ++out)
+        {
+            OutputType tmp = thrust::detail::device::dereference(iter);  // temporary value allows in-situ scan
+            thrust::detail::device::dereference(out) = sum;
+            sum = binary_op(sum, tmp);
+        }
+    }
+}; // end exclusive_downsweep_functor
+
+} // end namespace detail
+
 template<typename InputIterator,
          typename OutputIterator,
          typename AssociativeOperator>
@@ -35,20 +140,67 @@ template<typename InputIterator,
                                 OutputIterator result,
                                 AssociativeOperator binary_op)
 {
-    typedef typename thrust::iterator_traits<OutputIterator>::value_type OutputType;
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    typedef typename thrust::iterator_value<OutputIterator>::type      OutputType;
+    typedef typename thrust::iterator_difference<InputIterator>::type  difference_type;
+
+    difference_type n = last - first;
+
+    if (n == 0)
+        return result;
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    execution_config config = current_execution_config();
+
+    difference_type num_threads = detail::choose_num_threads(n, config);
+
+    difference_type num_blocks = omp::detail::reduction_num_blocks(n, num_threads);
+    difference_type block_size = (n + num_blocks - 1) / num_blocks;
+    num_blocks = (n + block_size - 1) / block_size;
+
+    // block_sums[i] holds the reduction of block i, then the carry-out of block i
+    thrust::detail::raw_omp_device_buffer<OutputType> block_sums(num_blocks);
+
+    typedef typename thrust::detail::raw_omp_device_buffer<OutputType>::iterator BufferIterator;
 
-    if(first != last)
+#   pragma omp parallel num_threads(std::min(num_threads, num_blocks)) if (num_threads > 1)
     {
-        OutputType sum = thrust::detail::device::dereference(first);
+        // upsweep: the last block's sum is never consumed
+        detail::worksharing_for(num_blocks - 1,
+                                detail::reduce_block_functor<InputIterator,BufferIterator,difference_type,AssociativeOperator>
+                                  (first, block_sums.begin(), n, block_size, binary_op),
+                                config.schedule, difference_type(1));
 
-        thrust::detail::device::dereference(result) = sum;
+        // propagate carries between blocks
+#       pragma omp single
+        {
+            for (difference_type i = 1; i < num_blocks - 1; i++)
+            {
+                OutputType carry = thrust::detail::device::dereference(block_sums.begin(), i - 1);
+                OutputType sum   = thrust::detail::device::dereference(block_sums.begin(), i);
+                thrust::detail::device::dereference(block_sums.begin(), i) = binary_op(carry, sum);
+            }
+        }
 
-        for(++first, ++result; first != last; ++first, ++result)
-            thrust::detail::device::dereference(result)
-              = sum = binary_op(sum, thrust::detail::device::dereference(first));
+        // downsweep
+        detail::worksharing_for(num_blocks,
+                                detail::inclusive_downsweep_functor<InputIterator,OutputIterator,BufferIterator,difference_type,AssociativeOperator>
+                                  (first, result, block_sums.begin(), n, block_size, binary_op),
+                                config.schedule, difference_type(1));
     }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 
-    return result;
+    return result + n;
 }
 
 template<typename InputIterator,
@@ -61,25 +213,71 @@ template<typename InputIterator,
                                 T init,
                                 AssociativeOperator binary_op)
 {
-    typedef typename thrust::iterator_traits<OutputIterator>::value_type OutputType;
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
 
-    if(first != last)
-    {
-        OutputType tmp = thrust::detail::device::dereference(first);  // temporary value allows in-situ scan
-        OutputType sum = init;
+    typedef typename thrust::iterator_value<OutputIterator>::type      OutputType;
+    typedef typename thrust::iterator_difference<InputIterator>::type  difference_type;
+
+    difference_type n = last - first;
+
+    if (n == 0)
+        return result;
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+// XXX implement the body of this function in another file to eliminate this ugliness
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    execution_config config = current_execution_config();
+
+    difference_type num_threads = detail::choose_num_threads(n, config);
+
+    difference_type num_blocks = omp::detail::reduction_num_blocks(n, num_threads);
+    difference_type block_size = (n + num_blocks - 1) / num_blocks;
+    num_blocks = (n + block_size - 1) / block_size;
 
-        thrust::detail::device::dereference(result) = sum;
-        sum = binary_op(sum, tmp);
+    // block_sums[i] holds the reduction of block i, then the carry-in of block i
+    thrust::detail::raw_omp_device_buffer<OutputType> block_sums(num_blocks);
 
-        for(++first, ++result; first != last; ++first, ++result)
+    typedef typename thrust::detail::raw_omp_device_buffer<OutputType>::iterator BufferIterator;
+
+#   pragma omp parallel num_threads(std::min(num_threads, num_blocks)) if (num_threads > 1)
+    {
+        // upsweep: the last block's sum is never consumed
+        detail::worksharing_for(num_blocks - 1,
+                                detail::reduce_block_functor<InputIterator,BufferIterator,difference_type,AssociativeOperator>
+                                  (first, block_sums.begin(), n, block_size, binary_op),
+                                config.schedule, difference_type(1));
+
+        // propagate carries between blocks
+#       pragma omp single
         {
-            tmp = thrust::detail::device::dereference(first);
-            thrust::detail::device::dereference(result) = sum;
-            sum = binary_op(sum, tmp);
+            OutputType carry = init;
+
+            for (difference_type i = 0; i < num_blocks - 1; i++)
+            {
+                OutputType sum = thrust::detail::device::dereference(block_sums.begin(), i);
+                thrust::detail::device::dereference(block_sums.begin(), i) = carry;
+                carry = binary_op(carry, sum);
+            }
+
+            thrust::detail::device::dereference(block_sums.begin(), num_blocks - 1) = carry;
         }
+
+        // downsweep
+        detail::worksharing_for(num_blocks,
+                                detail::exclusive_downsweep_functor<InputIterator,OutputIterator,BufferIterator,difference_type,AssociativeOperator>
+                                  (first, result, block_sums.begin(), n, block_size, binary_op),
+                                config.schedule, difference_type(1));
     }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 
-    return result;
+    return result + n;
 }
 
 } // end namespace omp
@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file set_intersection.inl
+ *  \brief Inline file for set_intersection.h.
+ */
+
+#include <thrust/detail/host/detail/set_operation.h>
+#include <thrust/detail/device/omp/detail/set_operation.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+  RandomAccessIterator3 set_intersection(RandomAccessIterator1 first1,
+                                         RandomAccessIterator1 last1,
+                                         RandomAccessIterator2 first2,
+                                         RandomAccessIterator2 last2,
+                                         RandomAccessIterator3 result,
+                                         StrictWeakOrdering comp)
+{
+  // the keys stand in for the (ignored) values
+  return thrust::detail::device::omp::detail::set_operation<thrust::detail::host::detail::set_intersection_policy,false>
+    (first1, last1, first2, last2, first1, first2, result, result, comp).first;
+} // end set_intersection()
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename RandomAccessIterator5,
+         typename RandomAccessIterator6,
+         typename StrictWeakOrdering>
+  thrust::pair<RandomAccessIterator5,RandomAccessIterator6>
+    set_intersection_by_key(RandomAccessIterator1 keys_first1,
+                            RandomAccessIterator1 keys_last1,
+                            RandomAccessIterator2 keys_first2,
+                            RandomAccessIterator2 keys_last2,
+                            RandomAccessIterator3 values_first1,
+                            RandomAccessIterator4 values_first2,
+                            RandomAccessIterator5 keys_result,
+                            RandomAccessIterator6 values_result,
+                            StrictWeakOrdering comp)
+{
+  return thrust::detail::device::omp::detail::set_operation<thrust::detail::host::detail::set_intersection_policy,true>
+    (keys_first1, keys_last1, keys_first2, keys_last2, values_first1, values_first2, keys_result, values_result, comp);
+} // end set_intersection_by_key()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
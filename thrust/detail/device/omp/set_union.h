@@ -0,0 +1,71 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file set_union.h
+ *  \brief OpenMP implementation of set_union.
+ */
+
+#pragma once
+
+#include <thrust/pair.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+  RandomAccessIterator3 set_union(RandomAccessIterator1 first1,
+                                  RandomAccessIterator1 last1,
+                                  RandomAccessIterator2 first2,
+                                  RandomAccessIterator2 last2,
+                                  RandomAccessIterator3 result,
+                                  StrictWeakOrdering comp);
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename RandomAccessIterator5,
+         typename RandomAccessIterator6,
+         typename StrictWeakOrdering>
+  thrust::pair<RandomAccessIterator5,RandomAccessIterator6>
+    set_union_by_key(RandomAccessIterator1 keys_first1,
+                     RandomAccessIterator1 keys_last1,
+                     RandomAccessIterator2 keys_first2,
+                     RandomAccessIterator2 keys_last2,
+                     RandomAccessIterator3 values_first1,
+                     RandomAccessIterator4 values_first2,
+                     RandomAccessIterator5 keys_result,
+                     RandomAccessIterator6 values_result,
+                     StrictWeakOrdering comp);
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/omp/set_union.inl>
+
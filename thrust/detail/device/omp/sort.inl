@@ -19,7 +19,27 @@
 
 #include <thrust/iterator/detail/forced_iterator.h> // XXX remove this we we have a proper OMP sort
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/functional.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/trivial_sequence.h>
+#include <thrust/copy.h>
 #include <thrust/detail/device/omp/dispatch/sort.h>
+#include <thrust/detail/device/omp/detail/stable_merge_sort.h>
+#include <thrust/detail/device/omp/detail/stable_radix_sort.h>
+
+
+/*
+ *  This file implements the following dispatch procedure for omp::stable_sort()
+ *  and omp::stable_sort_by_key().  The KeyType and StrictWeakOrdering are
+ *  inspected to determine whether Radix Sort may be applied.
+ *
+ *   Summary of the dispatch procedure:
+ *       if is_arithmetic<KeyType> && (is_equal< StrictWeakOrdering, less<KeyType> > ||
+ *                                     is_equal< StrictWeakOrdering, greater<KeyType> >)
+ *           stable_radix_sort()
+ *       else
+ *           merge sort
+ */
 
 
 namespace thrust
@@ -31,17 +51,98 @@ namespace device
 namespace omp
 {
 
+namespace first_dispatch
+{
+
 template<typename RandomAccessIterator,
          typename StrictWeakOrdering>
 void stable_sort(RandomAccessIterator first,
                  RandomAccessIterator last,
-                 StrictWeakOrdering comp)
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+    // ensure sequence has trivial iterators
+    thrust::detail::trivial_sequence<RandomAccessIterator> keys(first, last);
+
+    // OpenMP path for thrust::stable_sort with primitive keys
+    // (e.g. int, float, short, etc.) and the less<T> or greater<T>
+    // comparison methods is implemented with stable_radix_sort
+    thrust::detail::device::omp::detail::stable_radix_sort(keys.begin(), keys.end(), comp);
+
+    // copy results back, if necessary
+    if(!thrust::detail::is_trivial_iterator<RandomAccessIterator>::value)
+        thrust::copy(keys.begin(), keys.end(), first);
+}
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
     // dispatch on the trivialness of the iterator
     thrust::detail::device::omp::dispatch::stable_sort(first, last, comp,
         thrust::detail::is_trivial_iterator<RandomAccessIterator>());
 }
 
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::true_type)
+{
+    // OpenMP path for thrust::stable_sort_by_key with primitive keys
+    // (e.g. int, float, short, etc.) and the less<T> or greater<T>
+    // comparison methods is implemented with stable_radix_sort_by_key
+    thrust::detail::device::omp::detail::stable_radix_sort_by_key(keys_first, keys_last, values_first, comp);
+}
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::false_type)
+{
+    // OpenMP path for thrust::stable_sort_by_key with general keys
+    // and comparison methods is implemented with stable_merge_sort_by_key
+    thrust::detail::device::omp::detail::stable_merge_sort_by_key(keys_first, keys_last, values_first, comp);
+}
+
+} // end namespace first_dispatch
+
+
+template<typename KeyType,
+         typename StrictWeakOrdering>
+  struct use_radix_sort
+    : thrust::detail::integral_constant<
+        bool,
+        thrust::detail::is_arithmetic<KeyType>::value &&
+        (thrust::detail::is_same<StrictWeakOrdering, typename thrust::less<KeyType> >::value ||
+         thrust::detail::is_same<StrictWeakOrdering, typename thrust::greater<KeyType> >::value)
+      >
+{};
+
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+    // dispatch on whether we can use radix_sort
+    first_dispatch::stable_sort(first, last, comp,
+        use_radix_sort<KeyType,StrictWeakOrdering>());
+}
+
 template<typename RandomAccessIterator1,
          typename RandomAccessIterator2,
          typename StrictWeakOrdering>
@@ -52,11 +153,20 @@ void stable_sort_by_key(RandomAccessIterator1 keys_first,
 {
     typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
 
-    // XXX use host stable_sort_by_key implementation for now
-    thrust::detail::host::stable_sort_by_key(thrust::detail::make_forced_iterator(keys_first,   thrust::host_space_tag()),
-                                             thrust::detail::make_forced_iterator(keys_last,    thrust::host_space_tag()),
-                                             thrust::detail::make_forced_iterator(values_first, thrust::host_space_tag()),
-                                             comp);
+    // ensure sequences have trivial iterators
+    RandomAccessIterator2 values_last = values_first + (keys_last - keys_first);
+    thrust::detail::trivial_sequence<RandomAccessIterator1> keys(keys_first, keys_last);
+    thrust::detail::trivial_sequence<RandomAccessIterator2> values(values_first, values_last);
+
+    // dispatch on whether we can use radix_sort_by_key
+    first_dispatch::stable_sort_by_key(keys.begin(), keys.end(), values.begin(), comp,
+        use_radix_sort<KeyType,StrictWeakOrdering>());
+
+    // copy results back, if necessary
+    if(!thrust::detail::is_trivial_iterator<RandomAccessIterator1>::value)
+        thrust::copy(keys.begin(), keys.end(), keys_first);
+    if(!thrust::detail::is_trivial_iterator<RandomAccessIterator2>::value)
+        thrust::copy(values.begin(), values.end(), values_first);
 }
 
 } // end namespace omp
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file workspace_size.h
+ *  \brief The workspace required by the temporaries of OpenMP algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/device/workspace.h>
+#include <thrust/detail/device/omp/sort.h>
+#include <thrust/detail/device/omp/deterministic.h>
+#include <thrust/detail/device/omp/detail/parallel_for.h>
+#include <thrust/detail/device/omp/detail/stable_radix_sort.h>
+#include <cstddef>
+
+/*
+ *  Each function below mirrors the raw_buffer allocations of the
+ *  corresponding OpenMP algorithm applied to trivial iterators, with the
+ *  calling thread's current execution_config, and returns the largest number
+ *  of workspace bytes those temporaries occupy at once.
+ */
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+// block_sums of inclusive_scan and exclusive_scan
+template<typename T>
+std::size_t scan_workspace_bytes(std::size_t n)
+{
+    if (n == 0)
+        return 0;
+
+    std::ptrdiff_t num_threads = detail::choose_num_threads(std::ptrdiff_t(n));
+
+    std::ptrdiff_t num_blocks = detail::reduction_num_blocks(std::ptrdiff_t(n), num_threads);
+    std::ptrdiff_t block_size = (std::ptrdiff_t(n) + num_blocks - 1) / num_blocks;
+    num_blocks = (std::ptrdiff_t(n) + block_size - 1) / block_size;
+
+    return workspace_bytes(num_blocks * sizeof(T));
+}
+
+// offsets of copy_if
+inline std::size_t copy_if_workspace_bytes(std::size_t n)
+{
+    if (n == 0)
+        return 0;
+
+    int P = detail::choose_num_threads(std::ptrdiff_t(n));
+
+    return workspace_bytes((P + 1) * sizeof(std::ptrdiff_t));
+}
+
+// offsets and carries of reduce_by_key
+template<typename ValueType>
+std::size_t reduce_by_key_workspace_bytes(std::size_t n)
+{
+    if (n == 0)
+        return 0;
+
+    int P = detail::choose_num_threads(std::ptrdiff_t(n));
+
+    return workspace_bytes((P + 1) * sizeof(std::ptrdiff_t)) +
+           workspace_bytes(P * sizeof(ValueType));
+}
+
+namespace first_dispatch
+{
+
+// values_temp of stable_radix_sort_by_key, then the digit buffers and histograms of radix_sort
+template<typename KeyType,
+         typename ValueType,
+         typename StrictWeakOrdering>
+std::size_t stable_sort_by_key_workspace_bytes(std::size_t n,
+                                               thrust::detail::true_type)
+{
+    typedef typename detail::radix_key_codec<KeyType,StrictWeakOrdering>::bits_type bits_type;
+
+    std::size_t result = workspace_bytes(n * sizeof(ValueType));
+
+    if (n < 2)
+        return result;
+
+    int P = detail::choose_num_threads(std::ptrdiff_t(n));
+
+    return result +
+           2 * workspace_bytes(n * sizeof(bits_type)) +
+           workspace_bytes(P * 256 * sizeof(std::ptrdiff_t));
+}
+
+// keys_buffer and values_buffer of stable_merge_sort_by_key
+template<typename KeyType,
+         typename ValueType,
+         typename StrictWeakOrdering>
+std::size_t stable_sort_by_key_workspace_bytes(std::size_t n,
+                                               thrust::detail::false_type)
+{
+    if (n < 2)
+        return 0;
+
+    return workspace_bytes(n * sizeof(KeyType)) +
+           workspace_bytes(n * sizeof(ValueType));
+}
+
+} // end namespace first_dispatch
+
+template<typename KeyType,
+         typename ValueType,
+         typename StrictWeakOrdering>
+std::size_t stable_sort_by_key_workspace_bytes(std::size_t n)
+{
+    return first_dispatch::stable_sort_by_key_workspace_bytes<KeyType,ValueType,StrictWeakOrdering>(n,
+        use_radix_sort<KeyType,StrictWeakOrdering>());
+}
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
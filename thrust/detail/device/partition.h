@@ -21,7 +21,9 @@
 
 #pragma once
 
+#include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/generic/partition.h>
+#include <thrust/detail/device/dispatch/partition.h>
 
 namespace thrust
 {
@@ -36,7 +38,9 @@ template<typename ForwardIterator,
                                    ForwardIterator last,
                                    Predicate pred)
 {
-    return thrust::detail::device::generic::stable_partition(first, last, pred);
+    // dispatch on the space of the input
+    return thrust::detail::device::dispatch::stable_partition(first, last, pred,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template<typename ForwardIterator1,
@@ -56,7 +60,8 @@ template<typename ForwardIterator,
                             ForwardIterator last,
                             Predicate pred)
 {
-    return thrust::detail::device::generic::partition(first, last, pred);
+    // a stable partition is also a partition
+    return thrust::detail::device::stable_partition(first, last, pred);
 }
 
 template<typename ForwardIterator1,
@@ -22,7 +22,7 @@
 #pragma once
 
 #include <thrust/detail/device/dispatch/reduce.h>
-#include <thrust/detail/device/generic/reduce_by_key.h>
+#include <thrust/detail/device/dispatch/reduce_by_key.h>
 
 #include <thrust/iterator/iterator_traits.h>
 
@@ -61,8 +61,9 @@ template <typename InputIterator1,
                      BinaryPredicate binary_pred,
                      BinaryFunction binary_op)
 {
-    // use generic path
-    return thrust::detail::device::generic::reduce_by_key(keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+    // dispatch on the space of the output
+    return thrust::detail::device::dispatch::reduce_by_key(keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op,
+            typename thrust::iterator_space<OutputIterator1>::type());
 }
 
 } // end namespace device
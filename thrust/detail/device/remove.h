@@ -21,7 +21,9 @@
 
 #pragma once
 
+#include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/generic/remove.h>
+#include <thrust/detail/device/dispatch/remove.h>
 
 namespace thrust
 {
@@ -38,7 +40,9 @@ template<typename ForwardIterator,
                             InputIterator stencil,
                             Predicate pred)
 {
-    return thrust::detail::device::generic::remove_if(first, last, stencil, pred);
+    // dispatch on the space of the input
+    return thrust::detail::device::dispatch::remove_if(first, last, stencil, pred,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template<typename InputIterator,
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <thrust/pair.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/dispatch/set_intersection.h>
 
@@ -46,6 +47,35 @@ template<typename InputIterator1,
     typename thrust::iterator_space<OutputIterator>::type());
 } // end set_intersection()
 
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_intersection_by_key(InputIterator1 keys_first1,
+                            InputIterator1 keys_last1,
+                            InputIterator2 keys_first2,
+                            InputIterator2 keys_last2,
+                            InputIterator3 values_first1,
+                            InputIterator4 values_first2,
+                            OutputIterator1 keys_result,
+                            OutputIterator2 values_result,
+                            StrictWeakOrdering comp)
+{
+  // dispatch on space
+  return thrust::detail::device::dispatch::set_intersection_by_key(keys_first1,keys_last1,keys_first2,keys_last2,values_first1,values_first2,keys_result,values_result,comp,
+    typename thrust::iterator_space<InputIterator1>::type(),
+    typename thrust::iterator_space<InputIterator2>::type(),
+    typename thrust::iterator_space<InputIterator3>::type(),
+    typename thrust::iterator_space<InputIterator4>::type(),
+    typename thrust::iterator_space<OutputIterator1>::type(),
+    typename thrust::iterator_space<OutputIterator2>::type());
+} // end set_intersection_by_key()
+
 } // end device
 
 } // end detail
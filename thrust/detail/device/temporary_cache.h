@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file temporary_cache.h
+ *  \brief A thread-safe, size-class cache of device allocations
+ *         used for algorithm temporaries.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/device_ptr.h>
+#include <cstddef>
+
+// the cache is guarded by std::mutex, so it is only available with C++11
+#if (__cplusplus >= 201103L) || (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC)
+#define __THRUST_HAS_TEMPORARY_CACHE 1
+#else
+#define __THRUST_HAS_TEMPORARY_CACHE 0
+#endif
+
+#if __THRUST_HAS_TEMPORARY_CACHE
+#include <mutex>
+#include <vector>
+#include <unordered_set>
+#endif
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+
+#if __THRUST_HAS_TEMPORARY_CACHE
+
+// temporary_cache recycles blocks returned by caching_allocator.
+// Requests of up to max_cached_block_size bytes are rounded up to one of
+// classes_per_octave size classes per power of two, and freed blocks are
+// kept on a per-class free list as long as the total number of cached bytes
+// stays below limit().  Blocks which would exceed the limit are released
+// immediately.  Larger requests, and requests made while the limit is zero,
+// are allocated at their exact size and never cached, so that they cost no
+// more memory than without the cache.
+class temporary_cache
+{
+  public:
+    // the smallest size class, in bytes
+    static const std::size_t min_block_size = 256;
+
+    // the number of size classes between consecutive powers of two
+    static const unsigned int classes_per_octave = 4;
+
+    // the number of powers of two spanned by the size classes
+    static const unsigned int num_octaves = 18;
+
+    // the largest size class, in bytes (64 MB)
+    static const std::size_t max_cached_block_size = min_block_size << num_octaves;
+
+    static temporary_cache &instance();
+
+    ~temporary_cache();
+
+    thrust::device_ptr<void> allocate(std::size_t num_bytes);
+
+    void deallocate(thrust::device_ptr<void> ptr, std::size_t num_bytes) throw();
+
+    // releases every cached block
+    void trim() throw();
+
+    std::size_t limit() const;
+
+    // sets the high-water limit and releases cached blocks above it
+    void set_limit(std::size_t num_bytes);
+
+    std::size_t cached_bytes() const;
+
+  private:
+    static const unsigned int num_size_classes = num_octaves * classes_per_octave + 1;
+
+    temporary_cache();
+
+    static std::size_t default_limit();
+
+    // the size class of a request of at most max_cached_block_size bytes
+    static unsigned int size_class(std::size_t num_bytes);
+
+    static std::size_t class_block_size(unsigned int size_class);
+
+    // releases cached blocks until at most num_bytes remain cached
+    // the caller must hold m_mutex
+    void release_until(std::size_t num_bytes) throw();
+
+    mutable std::mutex m_mutex;
+    std::vector<void*> m_free_blocks[num_size_classes];
+    std::size_t m_cached_bytes;
+    std::size_t m_limit;
+
+    // the outstanding blocks of exact size allocated while the limit was
+    // zero, which must not be cached should the limit be raised meanwhile
+    std::unordered_set<void*> m_exact_blocks;
+
+    // disallow copy and assignment
+    temporary_cache(const temporary_cache &);
+    temporary_cache &operator=(const temporary_cache &);
+}; // end temporary_cache
+
+#endif // __THRUST_HAS_TEMPORARY_CACHE
+
+} // end device
+} // end detail
+} // end thrust
+
+#include <thrust/detail/device/temporary_cache.inl>
+
@@ -0,0 +1,252 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file temporary_cache.inl
+ *  \brief Inline file for temporary_cache.h.
+ */
+
+#include <thrust/detail/device/temporary_cache.h>
+
+#if __THRUST_HAS_TEMPORARY_CACHE
+
+#include <thrust/device_malloc.h>
+#include <thrust/detail/device/no_throw_free.h>
+#include <cstdlib>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+
+
+inline temporary_cache &temporary_cache::instance()
+{
+  static temporary_cache cache;
+  return cache;
+} // end temporary_cache::instance()
+
+
+inline temporary_cache::temporary_cache()
+  : m_cached_bytes(0), m_limit(default_limit())
+{}
+
+
+inline temporary_cache::~temporary_cache()
+{
+  trim();
+} // end temporary_cache::~temporary_cache()
+
+
+inline std::size_t temporary_cache::default_limit()
+{
+  // the limit may be given in megabytes through the environment
+  if(const char *env = std::getenv("THRUST_TEMPORARY_CACHE_LIMIT_MB"))
+  {
+    long megabytes = std::atol(env);
+
+    return megabytes > 0 ? static_cast<std::size_t>(megabytes) << 20 : 0;
+  } // end if
+
+  return std::size_t(256) << 20;
+} // end temporary_cache::default_limit()
+
+
+inline unsigned int temporary_cache::size_class(std::size_t num_bytes)
+{
+  if(num_bytes <= min_block_size)
+    return 0;
+
+  // find the octave (base, 2 * base] holding num_bytes
+  unsigned int octave = 0;
+  std::size_t base = min_block_size;
+
+  while(2 * base < num_bytes)
+  {
+    base <<= 1;
+    ++octave;
+  } // end while
+
+  // and the first class of the octave which is large enough
+  const std::size_t step = base / classes_per_octave;
+
+  return octave * classes_per_octave + static_cast<unsigned int>((num_bytes - base + step - 1) / step);
+} // end temporary_cache::size_class()
+
+
+inline std::size_t temporary_cache::class_block_size(unsigned int c)
+{
+  if(c == 0)
+    return min_block_size;
+
+  const std::size_t base = std::size_t(min_block_size) << ((c - 1) / classes_per_octave);
+
+  return base + ((c - 1) % classes_per_octave + 1) * (base / classes_per_octave);
+} // end temporary_cache::class_block_size()
+
+
+inline thrust::device_ptr<void> temporary_cache::allocate(std::size_t num_bytes)
+{
+  // requests too large for the biggest class are never cached
+  if(num_bytes > max_cached_block_size)
+    return thrust::device_malloc(num_bytes);
+
+  const unsigned int c = size_class(num_bytes);
+  const std::size_t block_size = class_block_size(c);
+
+  bool caching = true;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!m_free_blocks[c].empty())
+    {
+      void *result = m_free_blocks[c].back();
+      m_free_blocks[c].pop_back();
+      m_cached_bytes -= block_size;
+
+      return thrust::device_ptr<void>(result);
+    } // end if
+
+    caching = m_limit > 0;
+  }
+
+  if(!caching)
+  {
+    // the block will not be cached, so it need not fill its class
+    thrust::device_ptr<void> result = thrust::device_malloc(num_bytes);
+
+    try
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_exact_blocks.insert(result.get());
+    }
+    catch(...)
+    {
+      thrust::detail::device::no_throw_free(result);
+      throw;
+    }
+
+    return result;
+  } // end if
+
+  try
+  {
+    return thrust::device_malloc(block_size);
+  }
+  catch(std::bad_alloc &)
+  {
+    // give the cached blocks back and try again
+    trim();
+  }
+
+  return thrust::device_malloc(block_size);
+} // end temporary_cache::allocate()
+
+
+inline void temporary_cache::deallocate(thrust::device_ptr<void> ptr, std::size_t num_bytes) throw()
+{
+  if(num_bytes <= max_cached_block_size)
+  {
+    const unsigned int c = size_class(num_bytes);
+    const std::size_t block_size = class_block_size(c);
+
+    try
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      // a block allocated at its exact size is smaller than its class
+      const bool exact = !m_exact_blocks.empty() && m_exact_blocks.erase(ptr.get()) > 0;
+
+      if(!exact && m_cached_bytes + block_size <= m_limit)
+      {
+        m_free_blocks[c].push_back(ptr.get());
+        m_cached_bytes += block_size;
+        return;
+      } // end if
+    }
+    catch(...)
+    {
+      // fall through and release the block
+    }
+  } // end if
+
+  thrust::detail::device::no_throw_free(ptr);
+} // end temporary_cache::deallocate()
+
+
+inline void temporary_cache::release_until(std::size_t num_bytes) throw()
+{
+  // release the largest blocks first
+  for(unsigned int c = num_size_classes; c > 0 && m_cached_bytes > num_bytes; --c)
+  {
+    std::vector<void*> &blocks = m_free_blocks[c - 1];
+    const std::size_t block_size = class_block_size(c - 1);
+
+    while(!blocks.empty() && m_cached_bytes > num_bytes)
+    {
+      thrust::detail::device::no_throw_free(thrust::device_ptr<void>(blocks.back()));
+      blocks.pop_back();
+      m_cached_bytes -= block_size;
+    } // end while
+  } // end for
+} // end temporary_cache::release_until()
+
+
+inline void temporary_cache::trim() throw()
+{
+  try
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    release_until(0);
+  }
+  catch(...)
+  {
+    // locking failed; nothing to release
+  }
+} // end temporary_cache::trim()
+
+
+inline std::size_t temporary_cache::limit() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_limit;
+} // end temporary_cache::limit()
+
+
+inline void temporary_cache::set_limit(std::size_t num_bytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_limit = num_bytes;
+  release_until(m_limit);
+} // end temporary_cache::set_limit()
+
+
+inline std::size_t temporary_cache::cached_bytes() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cached_bytes;
+} // end temporary_cache::cached_bytes()
+
+
+} // end device
+} // end detail
+} // end thrust
+
+#endif // __THRUST_HAS_TEMPORARY_CACHE
+
@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file copy.inl
+ *  \brief Inline file for copy.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/minimum_category.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/threads/detail/parallel_for.h>
+
+// for std::copy
+#include <algorithm>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// TODO eliminate these three functors when we no longer need device::dereference()
+template<typename InputIterator,
+         typename OutputIterator>
+struct copy_device_to_device_functor
+{
+  InputIterator  first;
+  OutputIterator result;
+
+  copy_device_to_device_functor(InputIterator first, OutputIterator result)
+    : first(first), result(result) {}
+
+  template<typename Size>
+  void operator()(Size i)
+  {
+    InputIterator  first_temp  = first  + i;
+    OutputIterator result_temp = result + i;
+
+    thrust::detail::device::dereference(result_temp) = thrust::detail::device::dereference(first_temp);
+  }
+}; // end copy_device_to_device_functor
+
+template<typename InputIterator,
+         typename OutputIterator>
+struct copy_host_or_any_to_device_functor
+{
+  InputIterator  first;
+  OutputIterator result;
+
+  copy_host_or_any_to_device_functor(InputIterator first, OutputIterator result)
+    : first(first), result(result) {}
+
+  template<typename Size>
+  void operator()(Size i)
+  {
+    OutputIterator temp = result + i;
+    thrust::detail::device::dereference(temp) = first[i];
+  }
+}; // end copy_host_or_any_to_device_functor
+
+template<typename InputIterator,
+         typename OutputIterator>
+struct copy_device_to_host_or_any_functor
+{
+  InputIterator  first;
+  OutputIterator result;
+
+  copy_device_to_host_or_any_functor(InputIterator first, OutputIterator result)
+    : first(first), result(result) {}
+
+  template<typename Size>
+  void operator()(Size i)
+  {
+    InputIterator temp = first + i;
+    result[i] = thrust::detail::device::dereference(temp);
+  }
+}; // end copy_device_to_host_or_any_functor
+
+template<typename Functor,
+         typename InputIterator,
+         typename OutputIterator>
+OutputIterator parallel_copy(InputIterator first,
+                             InputIterator last,
+                             OutputIterator result)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+  difference n = last - first;
+
+  parallel_for(n, Functor(first, result));
+
+  return result + n;
+}
+
+} // end namespace detail
+
+namespace dispatch
+{
+
+// device to device
+template<typename InputIterator,
+         typename OutputIterator>
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    thrust::detail::threads_device_space_tag,
+                    thrust::detail::threads_device_space_tag)
+{
+  return detail::parallel_copy<
+    detail::copy_device_to_device_functor<InputIterator,OutputIterator>
+  >(first, last, result);
+}
+
+// host or any to device
+template<typename InputIterator,
+         typename OutputIterator,
+         typename HostOrAnySpaceTag>
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    HostOrAnySpaceTag,
+                    thrust::detail::threads_device_space_tag)
+{
+  return detail::parallel_copy<
+    detail::copy_host_or_any_to_device_functor<InputIterator,OutputIterator>
+  >(first, last, result);
+}
+
+// device to host or any
+template<typename InputIterator,
+         typename OutputIterator,
+         typename HostOrAnySpaceTag>
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    thrust::detail::threads_device_space_tag,
+                    HostOrAnySpaceTag)
+{
+  return detail::parallel_copy<
+    detail::copy_device_to_host_or_any_functor<InputIterator,OutputIterator>
+  >(first, last, result);
+}
+
+// random access to random access
+template<typename InputIterator,
+         typename OutputIterator>
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    thrust::random_access_traversal_tag)
+{
+  // dispatch on space
+  return thrust::detail::device::threads::dispatch::copy(first, last, result,
+    typename thrust::iterator_space<InputIterator>::type(),
+    typename thrust::iterator_space<OutputIterator>::type());
+} 
+
+// incrementable to incrementable
+template<typename InputIterator,
+         typename OutputIterator>
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    thrust::incrementable_traversal_tag)
+{
+  // serialize on the host
+  return std::copy(first,last,result);
+}
+
+} // end namespace dispatch
+
+
+template<typename InputIterator,
+         typename OutputIterator>
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result)
+{
+  typedef typename thrust::iterator_traversal<InputIterator>::type traversal1;
+  typedef typename thrust::iterator_traversal<OutputIterator>::type traversal2;
+
+  typedef typename thrust::detail::minimum_category<traversal1,traversal2>::type minimum_traversal;
+
+  // dispatch on min traversal
+  return thrust::detail::device::threads::dispatch::copy(first, last, result, minimum_traversal());
+} 
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
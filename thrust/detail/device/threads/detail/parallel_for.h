@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file parallel_for.h
+ *  \brief Loops over an index range on the threads backend's thread_pool.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/threads/detail/thread_pool.h>
+
+#include <algorithm>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// the fewest iterations parallel_for hands to a single task by default
+const unsigned int min_grain_size = 1 << 10;
+
+// returns the number of threads which may cooperate on a call
+inline unsigned int concurrency()
+{
+    return thread_pool::instance().concurrency();
+} // end concurrency()
+
+// returns a grain size which divides n iterations into a few tasks per
+// thread, so that stealing can balance the load, but no smaller than min_grain_size
+template <typename Size>
+Size default_grain_size(Size n)
+{
+    Size num_tasks = Size(4) * Size(concurrency());
+
+    return std::max<Size>(Size(min_grain_size), (n + num_tasks - 1) / num_tasks);
+} // end default_grain_size()
+
+template <typename Size, typename Function>
+void parallel_for(Size first, Size last, Function f, Size grain);
+
+template <typename Size, typename Function>
+struct parallel_for_task
+{
+    Size first, last;
+    Function f;
+    Size grain;
+
+    parallel_for_task(Size first, Size last, Function f, Size grain)
+      : first(first), last(last), f(f), grain(grain) {}
+
+    void operator()() const
+    {
+        parallel_for(first, last, f, grain);
+    }
+}; // end parallel_for_task
+
+// calls f(i) for every i in [first, last).  the range is halved recursively:
+// the upper halves are submitted to the pool and the calling thread keeps the
+// lower half, until no more than grain iterations remain
+template <typename Size, typename Function>
+void parallel_for(Size first, Size last, Function f, Size grain)
+{
+    grain = std::max<Size>(grain, Size(1));
+
+    if (last - first > grain)
+    {
+        task_group group;
+
+        while (last - first > grain)
+        {
+            Size middle = first + (last - first) / 2;
+            group.run(parallel_for_task<Size,Function>(middle, last, f, grain));
+            last = middle;
+        }
+
+        for (Size i = first; i < last; i++)
+            f(i);
+
+        group.wait();
+    }
+    else
+    {
+        for (Size i = first; i < last; i++)
+            f(i);
+    }
+} // end parallel_for()
+
+// calls f(i) for every i in [0, n) in parallel, at most grain iterations per task
+template <typename Size, typename Function>
+void parallel_for(Size n, Function f, Size grain)
+{
+    parallel_for(Size(0), n, f, grain);
+} // end parallel_for()
+
+// calls f(i) for every i in [0, n) in parallel
+template <typename Size, typename Function>
+void parallel_for(Size n, Function f)
+{
+    parallel_for(Size(0), n, f, default_grain_size(n));
+} // end parallel_for()
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file stable_merge_sort.h
+ *  \brief Task parallel merge sort on raw pointers [std::thread]
+ */
+
+#pragma once
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// sorts [first, last) stably, using [buffer, buffer + (last - first)) as scratch space
+template<typename T,
+         typename StrictWeakOrdering>
+void stable_merge_sort(T *first,
+                       T *last,
+                       T *buffer,
+                       StrictWeakOrdering comp);
+
+// merges the sorted ranges [first1, last1) and [first2, last2) into result.
+// elements of the first range precede equivalent elements of the second
+template<typename T,
+         typename StrictWeakOrdering>
+void parallel_merge(const T *first1, const T *last1,
+                    const T *first2, const T *last2,
+                    T *result,
+                    StrictWeakOrdering comp);
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/threads/detail/stable_merge_sort.inl>
+
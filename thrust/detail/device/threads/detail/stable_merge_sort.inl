@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file stable_merge_sort.inl
+ *  \brief Inline file for stable_merge_sort.h.
+ */
+
+#include <thrust/detail/device/threads/detail/thread_pool.h>
+#include <thrust/detail/device/threads/detail/parallel_for.h>
+
+#include <algorithm>
+#include <cstddef>
+
+/*
+ *  The sort recursively halves its input, sorting the halves as independent
+ *  tasks, until pieces are small enough to sort serially with std::stable_sort.
+ *  Sorted halves are combined with a parallel merge, which splits the longer
+ *  run at its midpoint, binary searches for the matching split of the shorter
+ *  run, and merges the two resulting pairs of runs as independent tasks.  Each
+ *  level of the recursion ping-pongs between the input and the buffer, so no
+ *  data is copied back after merging.
+ */
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+namespace merge_sort_detail
+{
+
+template<typename T,
+         typename StrictWeakOrdering>
+void merge(const T *first1, const T *last1,
+           const T *first2, const T *last2,
+           T *result,
+           StrictWeakOrdering comp,
+           std::ptrdiff_t grain);
+
+template<typename T,
+         typename StrictWeakOrdering>
+struct merge_task
+{
+    const T *first1, *last1, *first2, *last2;
+    T *result;
+    StrictWeakOrdering comp;
+    std::ptrdiff_t grain;
+
+    merge_task(const T *first1, const T *last1, const T *first2, const T *last2,
+               T *result, StrictWeakOrdering comp, std::ptrdiff_t grain)
+      : first1(first1), last1(last1), first2(first2), last2(last2),
+        result(result), comp(comp), grain(grain) {}
+
+    void operator()() const
+    {
+        merge(first1, last1, first2, last2, result, comp, grain);
+    }
+}; // end merge_task
+
+template<typename T,
+         typename StrictWeakOrdering>
+void merge(const T *first1, const T *last1,
+           const T *first2, const T *last2,
+           T *result,
+           StrictWeakOrdering comp,
+           std::ptrdiff_t grain)
+{
+    std::ptrdiff_t n1 = last1 - first1;
+    std::ptrdiff_t n2 = last2 - first2;
+
+    if (n1 + n2 <= grain)
+    {
+        std::merge(first1, last1, first2, last2, result, comp);
+        return;
+    }
+
+    const T *split1, *split2;
+
+    if (n1 >= n2)
+    {
+        // elements of the second run equivalent to *split1 belong after it
+        split1 = first1 + n1 / 2;
+        split2 = std::lower_bound(first2, last2, *split1, comp);
+    }
+    else
+    {
+        // elements of the first run equivalent to *split2 belong before it
+        split2 = first2 + n2 / 2;
+        split1 = std::upper_bound(first1, last1, *split2, comp);
+    }
+
+    task_group group;
+
+    group.run(merge_task<T,StrictWeakOrdering>(split1, last1, split2, last2,
+                                               result + (split1 - first1) + (split2 - first2),
+                                               comp, grain));
+
+    merge(first1, split1, first2, split2, result, comp, grain);
+
+    group.wait();
+} // end merge()
+
+// sorts [first, last) into first if !to_buffer, and into buffer otherwise.
+// the other range serves as scratch space
+template<typename T,
+         typename StrictWeakOrdering>
+void sort(T *first, T *last, T *buffer, bool to_buffer,
+          StrictWeakOrdering comp, std::ptrdiff_t grain);
+
+template<typename T,
+         typename StrictWeakOrdering>
+struct sort_task
+{
+    T *first, *last, *buffer;
+    bool to_buffer;
+    StrictWeakOrdering comp;
+    std::ptrdiff_t grain;
+
+    sort_task(T *first, T *last, T *buffer, bool to_buffer,
+              StrictWeakOrdering comp, std::ptrdiff_t grain)
+      : first(first), last(last), buffer(buffer), to_buffer(to_buffer), comp(comp), grain(grain) {}
+
+    void operator()() const
+    {
+        sort(first, last, buffer, to_buffer, comp, grain);
+    }
+}; // end sort_task
+
+template<typename T,
+         typename StrictWeakOrdering>
+void sort(T *first, T *last, T *buffer, bool to_buffer,
+          StrictWeakOrdering comp, std::ptrdiff_t grain)
+{
+    std::ptrdiff_t n = last - first;
+
+    if (n <= grain)
+    {
+        std::stable_sort(first, last, comp);
+
+        if (to_buffer)
+            std::copy(first, last, buffer);
+
+        return;
+    }
+
+    std::ptrdiff_t half = n / 2;
+
+    // sort both halves into the range which is not the destination of the merge
+    {
+        task_group group;
+
+        group.run(sort_task<T,StrictWeakOrdering>(first + half, last, buffer + half, !to_buffer, comp, grain));
+
+        sort(first, first + half, buffer, !to_buffer, comp, grain);
+
+        group.wait();
+    }
+
+    if (to_buffer)
+        merge(first, first + half, first + half, last, buffer, comp, grain);
+    else
+        merge(buffer, buffer + half, buffer + half, buffer + n, first, comp, grain);
+} // end sort()
+
+} // end namespace merge_sort_detail
+
+
+template<typename T,
+         typename StrictWeakOrdering>
+void stable_merge_sort(T *first,
+                       T *last,
+                       T *buffer,
+                       StrictWeakOrdering comp)
+{
+    std::ptrdiff_t n = last - first;
+
+    if (n < 2)
+        return;
+
+    merge_sort_detail::sort(first, last, buffer, false, comp, default_grain_size(n));
+} // end stable_merge_sort()
+
+
+template<typename T,
+         typename StrictWeakOrdering>
+void parallel_merge(const T *first1, const T *last1,
+                    const T *first2, const T *last2,
+                    T *result,
+                    StrictWeakOrdering comp)
+{
+    std::ptrdiff_t n = (last1 - first1) + (last2 - first2);
+
+    merge_sort_detail::merge(first1, last1, first2, last2, result, comp, default_grain_size(n));
+} // end parallel_merge()
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,173 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file thread_pool.h
+ *  \brief A persistent pool of std::threads with per-worker work-stealing queues.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if (__cplusplus < 201103L) && (THRUST_HOST_COMPILER != THRUST_HOST_COMPILER_MSVC)
+#error The threads device backend requires C++11 support (e.g. -std=c++11).
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// a unit of work submitted to a thread_pool
+// execute() is called exactly once, and is responsible for deleting the task
+class task
+{
+  public:
+    virtual ~task() {}
+
+    virtual void execute() = 0;
+}; // end task
+
+
+// thread_pool owns a fixed set of worker threads.  Each worker has its own
+// queue: it pushes and pops tasks at the back (LIFO), while idle workers steal
+// from the front of other queues (FIFO), so the oldest, and typically largest,
+// tasks migrate.  Threads which are not workers submit to a shared queue.
+class thread_pool
+{
+  public:
+    // the pool shared by all algorithms, created upon first use.
+    // its size is taken from the THRUST_NUM_THREADS environment variable, if
+    // set, otherwise from std::thread::hardware_concurrency()
+    static thread_pool &instance();
+
+    // creates a pool with num_workers worker threads
+    explicit thread_pool(unsigned int num_workers);
+
+    ~thread_pool();
+
+    // returns the number of worker threads
+    unsigned int num_workers() const;
+
+    // returns the number of threads which may cooperate on a call:
+    // the workers plus the calling thread
+    unsigned int concurrency() const;
+
+    // queues t for execution
+    void submit(task *t);
+
+    // executes a single queued task, if one can be found.
+    // returns false if no task was found
+    bool run_pending_task();
+
+  private:
+    struct work_queue
+    {
+      std::mutex         mutex;
+      std::deque<task *> tasks;
+    }; // end work_queue
+
+    // returns the index of the calling thread's queue
+    unsigned int queue_index() const;
+
+    bool pop(unsigned int queue, task *&t);
+
+    bool steal(unsigned int thief, task *&t);
+
+    void worker_loop(unsigned int index);
+
+    static unsigned int default_num_workers();
+
+    // the calling thread's pool and worker index, if it is a worker
+    static thread_pool  *&current_pool();
+    static unsigned int  &current_worker();
+
+    // one queue per worker, followed by the queue shared by other threads
+    std::vector<std::unique_ptr<work_queue> > m_queues;
+    std::vector<std::thread>                  m_threads;
+
+    // the number of queued tasks, so sleeping workers can tell when to wake
+    std::atomic<int>        m_num_queued;
+    std::mutex              m_sleep_mutex;
+    std::condition_variable m_wake;
+    bool                    m_done;
+
+    // disallow copies
+    thread_pool(const thread_pool &);
+    thread_pool &operator=(const thread_pool &);
+}; // end thread_pool
+
+
+// task_group tracks a set of tasks submitted to the shared thread_pool.
+// wait() blocks until they all complete; the waiting thread executes queued
+// tasks rather than idling, so task_groups may nest to any depth.
+// if a task throws, the first exception is rethrown by wait()
+class task_group
+{
+  public:
+    task_group();
+
+    // waits for any outstanding tasks, discarding their exceptions
+    ~task_group();
+
+    // submits a copy of the nullary function f for execution
+    template<typename Function>
+    void run(const Function &f);
+
+    // waits for all submitted tasks and rethrows the first exception thrown by one
+    void wait();
+
+  private:
+    template<typename Function> class function_task;
+
+    void wait_for_tasks();
+
+    void finish_task(std::exception_ptr e);
+
+    thread_pool        &m_pool;
+    std::atomic<int>    m_num_pending;
+    std::mutex          m_exception_mutex;
+    std::exception_ptr  m_exception;
+
+    // disallow copies
+    task_group(const task_group &);
+    task_group &operator=(const task_group &);
+}; // end task_group
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/threads/detail/thread_pool.inl>
+
@@ -0,0 +1,311 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file thread_pool.inl
+ *  \brief Inline file for thread_pool.h.
+ */
+
+#include <cstdlib>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+
+inline thread_pool &thread_pool::instance()
+{
+  static thread_pool pool(default_num_workers());
+  return pool;
+} // end thread_pool::instance()
+
+
+inline thread_pool::thread_pool(unsigned int num_workers)
+  : m_num_queued(0), m_done(false)
+{
+  for(unsigned int i = 0; i <= num_workers; ++i)
+    m_queues.push_back(std::unique_ptr<work_queue>(new work_queue));
+
+  for(unsigned int i = 0; i < num_workers; ++i)
+    m_threads.push_back(std::thread(&thread_pool::worker_loop, this, i));
+} // end thread_pool::thread_pool()
+
+
+inline thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    m_done = true;
+  }
+  m_wake.notify_all();
+
+  for(unsigned int i = 0; i < m_threads.size(); ++i)
+    m_threads[i].join();
+} // end thread_pool::~thread_pool()
+
+
+inline unsigned int thread_pool::num_workers() const
+{
+  return static_cast<unsigned int>(m_threads.size());
+} // end thread_pool::num_workers()
+
+
+inline unsigned int thread_pool::concurrency() const
+{
+  return num_workers() + 1;
+} // end thread_pool::concurrency()
+
+
+inline void thread_pool::submit(task *t)
+{
+  work_queue &queue = *m_queues[queue_index()];
+
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(t);
+    ++m_num_queued;
+  }
+
+  // acquire the sleep mutex so a worker between testing m_num_queued
+  // and blocking cannot miss the notification
+  {
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+  }
+  m_wake.notify_one();
+} // end thread_pool::submit()
+
+
+inline bool thread_pool::run_pending_task()
+{
+  unsigned int index = queue_index();
+
+  task *t = 0;
+  if(pop(index, t) || steal(index, t))
+  {
+    t->execute();
+    return true;
+  }
+
+  return false;
+} // end thread_pool::run_pending_task()
+
+
+inline unsigned int thread_pool::queue_index() const
+{
+  // threads outside of this pool share the final queue
+  return current_pool() == this ? current_worker() : num_workers();
+} // end thread_pool::queue_index()
+
+
+inline bool thread_pool::pop(unsigned int index, task *&t)
+{
+  work_queue &queue = *m_queues[index];
+
+  std::lock_guard<std::mutex> lock(queue.mutex);
+
+  if(queue.tasks.empty()) return false;
+
+  // take the newest task
+  t = queue.tasks.back();
+  queue.tasks.pop_back();
+  --m_num_queued;
+
+  return true;
+} // end thread_pool::pop()
+
+
+inline bool thread_pool::steal(unsigned int thief, task *&t)
+{
+  const unsigned int num_queues = static_cast<unsigned int>(m_queues.size());
+
+  for(unsigned int i = 1; i < num_queues; ++i)
+  {
+    work_queue &queue = *m_queues[(thief + i) % num_queues];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if(queue.tasks.empty()) continue;
+
+    // take the oldest task
+    t = queue.tasks.front();
+    queue.tasks.pop_front();
+    --m_num_queued;
+
+    return true;
+  }
+
+  return false;
+} // end thread_pool::steal()
+
+
+inline void thread_pool::worker_loop(unsigned int index)
+{
+  current_pool()   = this;
+  current_worker() = index;
+
+  while(true)
+  {
+    task *t = 0;
+    if(pop(index, t) || steal(index, t))
+    {
+      t->execute();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_sleep_mutex);
+
+    while(!m_done && m_num_queued.load() == 0)
+      m_wake.wait(lock);
+
+    if(m_done) return;
+  }
+} // end thread_pool::worker_loop()
+
+
+inline unsigned int thread_pool::default_num_workers()
+{
+  int num_threads = 0;
+
+  if(const char *env = std::getenv("THRUST_NUM_THREADS"))
+    num_threads = std::atoi(env);
+
+  if(num_threads <= 0)
+    num_threads = static_cast<int>(std::thread::hardware_concurrency());
+
+  // the calling thread participates, so it needs no worker
+  return num_threads > 1 ? static_cast<unsigned int>(num_threads - 1) : 0u;
+} // end thread_pool::default_num_workers()
+
+
+inline thread_pool *&thread_pool::current_pool()
+{
+  static thread_local thread_pool *pool = 0;
+  return pool;
+} // end thread_pool::current_pool()
+
+
+inline unsigned int &thread_pool::current_worker()
+{
+  static thread_local unsigned int worker = 0;
+  return worker;
+} // end thread_pool::current_worker()
+
+
+template<typename Function>
+  class task_group::function_task
+    : public task
+{
+  public:
+    function_task(task_group &group, const Function &f)
+      : m_group(group), m_f(f)
+    {}
+
+    void execute()
+    {
+      std::exception_ptr e;
+
+      try
+      {
+        m_f();
+      }
+      catch(...)
+      {
+        e = std::current_exception();
+      }
+
+      // the group may be destroyed as soon as it is notified
+      task_group &group = m_group;
+      delete this;
+      group.finish_task(e);
+    }
+
+  private:
+    task_group &m_group;
+    Function    m_f;
+}; // end task_group::function_task
+
+
+inline task_group::task_group()
+  : m_pool(thread_pool::instance()), m_num_pending(0)
+{}
+
+
+inline task_group::~task_group()
+{
+  wait_for_tasks();
+} // end task_group::~task_group()
+
+
+template<typename Function>
+  void task_group::run(const Function &f)
+{
+  task *t = new function_task<Function>(*this, f);
+
+  ++m_num_pending;
+  m_pool.submit(t);
+} // end task_group::run()
+
+
+inline void task_group::wait()
+{
+  wait_for_tasks();
+
+  if(m_exception)
+  {
+    std::exception_ptr e = m_exception;
+    m_exception = std::exception_ptr();
+    std::rethrow_exception(e);
+  }
+} // end task_group::wait()
+
+
+inline void task_group::wait_for_tasks()
+{
+  // help with queued work rather than block
+  while(m_num_pending.load() > 0)
+  {
+    if(!m_pool.run_pending_task())
+      std::this_thread::yield();
+  }
+} // end task_group::wait_for_tasks()
+
+
+inline void task_group::finish_task(std::exception_ptr e)
+{
+  if(e)
+  {
+    std::lock_guard<std::mutex> lock(m_exception_mutex);
+
+    // keep the first exception
+    if(!m_exception) m_exception = e;
+  }
+
+  --m_num_pending;
+} // end task_group::finish_task()
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file for_each.inl
+ *  \brief Inline file for for_each.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/detail/device/threads/detail/parallel_for.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+template<typename InputIterator,
+         typename UnaryFunction>
+struct for_each_functor
+{
+  InputIterator first;
+  UnaryFunction f;
+
+  for_each_functor(InputIterator first, UnaryFunction f)
+    : first(first), f(f) {}
+
+  template<typename Size>
+  void operator()(Size i)
+  {
+    InputIterator temp = first + i;
+    f(thrust::detail::device::dereference(temp));
+  }
+}; // end for_each_functor
+
+} // end namespace detail
+
+template<typename InputIterator,
+         typename UnaryFunction>
+void for_each(InputIterator first,
+              InputIterator last,
+              UnaryFunction f)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+  difference n = thrust::distance(first,last);
+
+  thrust::detail::device::threads::detail::parallel_for
+    (n, detail::for_each_functor<InputIterator,UnaryFunction>(first, f));
+} 
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
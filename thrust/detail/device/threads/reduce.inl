@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file reduce.inl
+ *  \brief Inline file for reduce.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/threads/detail/parallel_for.h>
+
+#include <algorithm>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// reduces block i of [first, first + n) into result[i]
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename BinaryFunction>
+struct reduce_block_functor
+{
+    typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
+
+    InputIterator first;
+    OutputIterator result;
+    Size n, block_size;
+    BinaryFunction binary_op;
+
+    reduce_block_functor(InputIterator first, OutputIterator result,
+                         Size n, Size block_size,
+                         BinaryFunction binary_op)
+      : first(first), result(result), n(n), block_size(block_size), binary_op(binary_op) {}
+
+    void operator()(Size block)
+    {
+        InputIterator iter = first + block * block_size;
+        InputIterator end  = first + std::min<Size>((block + 1) * block_size, n);
+
+        OutputType block_sum = thrust::detail::device::dereference(iter);
+
+        for (++iter; iter != end; ++iter)
+            block_sum = binary_op(block_sum, thrust::detail::device::dereference(iter));
+
+        thrust::detail::device::dereference(result, block) = block_sum;
+    }
+}; // end reduce_block_functor
+
+} // end namespace detail
+
+template<typename InputIterator, 
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType reduce(InputIterator first,
+                    InputIterator last,
+                    OutputType init,
+                    BinaryFunction binary_op)
+{
+    typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+    difference_type n = last - first;
+
+    if (n == 0)
+        return init;
+
+    // split the input into contiguous blocks, reduce the blocks in parallel,
+    // and combine the block results left to right
+    difference_type block_size = detail::default_grain_size(n);
+    difference_type num_blocks = (n + block_size - 1) / block_size;
+
+    thrust::detail::raw_threads_device_buffer<OutputType> block_results(num_blocks);
+
+    typedef typename thrust::detail::raw_threads_device_buffer<OutputType>::iterator BufferIterator;
+
+    detail::parallel_for(num_blocks,
+                         detail::reduce_block_functor<InputIterator,BufferIterator,difference_type,BinaryFunction>
+                           (first, block_results.begin(), n, block_size, binary_op),
+                         difference_type(1));
+
+    OutputType total_sum = init;
+
+    for (BufferIterator result = block_results.begin(); result != block_results.end(); ++result)
+        total_sum = binary_op(total_sum, thrust::detail::device::dereference(result));
+
+    return total_sum;
+}
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
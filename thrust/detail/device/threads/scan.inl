@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file scan.inl
+ *  \brief Inline file for scan.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/threads/reduce.h>
+#include <thrust/detail/device/threads/detail/parallel_for.h>
+
+#include <algorithm>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+
+// The scans below use the three phase blocked algorithm of the omp backend.
+// The input is split into contiguous blocks, a few per thread.  First, every
+// block but the last is reduced (upsweep).  Next, the calling thread scans the
+// block sums to produce each block's carry-in.  Finally, every block is
+// scanned starting from its carry-in (downsweep).  Blocks are combined
+// strictly left to right, so binary_op need only be associative.  Each input
+// element is read before its corresponding output is written, so the scans
+// may be performed in-place.
+
+namespace detail
+{
+
+// scans block i of [first, first + n) into result, starting from the
+// carry-out of block i - 1
+template<typename InputIterator,
+         typename OutputIterator,
+         typename BufferIterator,
+         typename Size,
+         typename AssociativeOperator>
+struct inclusive_downsweep_functor
+{
+    typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
+
+    InputIterator first;
+    OutputIterator result;
+    BufferIterator block_sums;
+    Size n, block_size;
+    AssociativeOperator binary_op;
+
+    inclusive_downsweep_functor(InputIterator first, OutputIterator result, BufferIterator block_sums,
+                                Size n, Size block_size, AssociativeOperator binary_op)
+      : first(first), result(result), block_sums(block_sums), n(n), block_size(block_size), binary_op(binary_op) {}
+
+    void operator()(Size block)
+    {
+        InputIterator  iter = first  + block * block_size;
+        InputIterator  end  = first  + std::min<Size>((block + 1) * block_size, n);
+        OutputIterator out  = result + block * block_size;
+
+        OutputType sum = thrust::detail::device::dereference(iter);
+
+        if (block > 0)
+            sum = binary_op(OutputType(thrust::detail::device::dereference(block_sums, block - 1)), sum);
+
+        thrust::detail::device::dereference(out) = sum;
+
+        for(++iter, ++out; iter != end; ++iter, ++out)
+            thrust::detail::device::dereference(out)
+              = sum = binary_op(sum, thrust::detail::device::dereference(iter));
+    }
+}; // end inclusive_downsweep_functor
+
+// scans block i of [first, first + n) into result, starting from the
+// carry-in of block i
+template<typename InputIterator,
+         typename OutputIterator,
+         typename BufferIterator,
+         typename Size,
+         typename AssociativeOperator>
+struct exclusive_downsweep_functor
+{
+    typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
+
+    InputIterator first;
+    OutputIterator result;
+    BufferIterator block_sums;
+    Size n, block_size;
+    AssociativeOperator binary_op;
+
+    exclusive_downsweep_functor(InputIterator first, OutputIterator result, BufferIterator block_sums,
+                                Size n, Size block_size, AssociativeOperator binary_op)
+      : first(first), result(result), block_sums(block_sums), n(n), block_size(block_size), binary_op(binary_op) {}
+
+    void operator()(Size block)
+    {
+        InputIterator  iter = first  + block * block_size;
+        InputIterator  end  = first  + std::min<Size>((block + 1) * block_size, n);
+        OutputIterator out  = result + block * block_size;
+
+        OutputType sum = thrust::detail::device::dereference(block_sums, block);
+
+        for(; iter != end; ++iter, ++out)
+        {
+            OutputType tmp = thrust::detail::device::dereference(iter);  // temporary value allows in-situ scan
+            thrust::detail::device::dereference(out) = sum;
+            sum = binary_op(sum, tmp);
+        }
+    }
+}; // end exclusive_downsweep_functor
+
+} // end namespace detail
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator>
+  OutputIterator inclusive_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                AssociativeOperator binary_op)
+{
+    typedef typename thrust::iterator_value<OutputIterator>::type      OutputType;
+    typedef typename thrust::iterator_difference<InputIterator>::type  difference_type;
+
+    difference_type n = last - first;
+
+    if (n == 0)
+        return result;
+
+    difference_type block_size = detail::default_grain_size(n);
+    difference_type num_blocks = (n + block_size - 1) / block_size;
+
+    // block_sums[i] holds the reduction of block i, then the carry-out of block i
+    thrust::detail::raw_threads_device_buffer<OutputType> block_sums(num_blocks);
+
+    typedef typename thrust::detail::raw_threads_device_buffer<OutputType>::iterator BufferIterator;
+
+    // upsweep: the last block's sum is never consumed
+    detail::parallel_for(num_blocks - 1,
+                         detail::reduce_block_functor<InputIterator,BufferIterator,difference_type,AssociativeOperator>
+                           (first, block_sums.begin(), n, block_size, binary_op),
+                         difference_type(1));
+
+    // propagate carries between blocks
+    for (difference_type i = 1; i < num_blocks - 1; i++)
+    {
+        OutputType carry = thrust::detail::device::dereference(block_sums.begin(), i - 1);
+        OutputType sum   = thrust::detail::device::dereference(block_sums.begin(), i);
+        thrust::detail::device::dereference(block_sums.begin(), i) = binary_op(carry, sum);
+    }
+
+    // downsweep
+    detail::parallel_for(num_blocks,
+                         detail::inclusive_downsweep_functor<InputIterator,OutputIterator,BufferIterator,difference_type,AssociativeOperator>
+                           (first, result, block_sums.begin(), n, block_size, binary_op),
+                         difference_type(1));
+
+    return result + n;
+}
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator>
+  OutputIterator exclusive_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                T init,
+                                AssociativeOperator binary_op)
+{
+    typedef typename thrust::iterator_value<OutputIterator>::type      OutputType;
+    typedef typename thrust::iterator_difference<InputIterator>::type  difference_type;
+
+    difference_type n = last - first;
+
+    if (n == 0)
+        return result;
+
+    difference_type block_size = detail::default_grain_size(n);
+    difference_type num_blocks = (n + block_size - 1) / block_size;
+
+    // block_sums[i] holds the reduction of block i, then the carry-in of block i
+    thrust::detail::raw_threads_device_buffer<OutputType> block_sums(num_blocks);
+
+    typedef typename thrust::detail::raw_threads_device_buffer<OutputType>::iterator BufferIterator;
+
+    // upsweep: the last block's sum is never consumed
+    detail::parallel_for(num_blocks - 1,
+                         detail::reduce_block_functor<InputIterator,BufferIterator,difference_type,AssociativeOperator>
+                           (first, block_sums.begin(), n, block_size, binary_op),
+                         difference_type(1));
+
+    // propagate carries between blocks
+    OutputType carry = init;
+
+    for (difference_type i = 0; i < num_blocks - 1; i++)
+    {
+        OutputType sum = thrust::detail::device::dereference(block_sums.begin(), i);
+        thrust::detail::device::dereference(block_sums.begin(), i) = carry;
+        carry = binary_op(carry, sum);
+    }
+
+    thrust::detail::device::dereference(block_sums.begin(), num_blocks - 1) = carry;
+
+    // downsweep
+    detail::parallel_for(num_blocks,
+                         detail::exclusive_downsweep_functor<InputIterator,OutputIterator,BufferIterator,difference_type,AssociativeOperator>
+                           (first, result, block_sums.begin(), n, block_size, binary_op),
+                         difference_type(1));
+
+    return result + n;
+}
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
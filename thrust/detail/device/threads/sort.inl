@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file sort.inl
+ *  \brief Inline file for sort.h.
+ */
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/device_ptr.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/trivial_sequence.h>
+#include <thrust/copy.h>
+#include <thrust/detail/device/threads/detail/parallel_for.h>
+#include <thrust/detail/device/threads/detail/stable_merge_sort.h>
+
+/*
+ *  stable_sort() copies its input to a trivial sequence, if necessary, and
+ *  merge sorts it in place.  stable_sort_by_key() merge sorts the permutation
+ *  of indices which sorts the keys, then gathers the keys and values through
+ *  the permutation, so the values are moved exactly once.
+ */
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// compares positions of a key sequence by their keys
+template<typename KeyType,
+         typename StrictWeakOrdering>
+struct indirect_comp
+{
+    const KeyType *keys;
+    StrictWeakOrdering comp;
+
+    indirect_comp(const KeyType *keys, StrictWeakOrdering comp)
+      : keys(keys), comp(comp) {}
+
+    template<typename Size>
+    bool operator()(Size lhs, Size rhs)
+    {
+        return comp(keys[lhs], keys[rhs]);
+    }
+}; // end indirect_comp
+
+template<typename Size>
+struct sequence_functor
+{
+    Size *result;
+
+    sequence_functor(Size *result)
+      : result(result) {}
+
+    void operator()(Size i)
+    {
+        result[i] = i;
+    }
+}; // end sequence_functor
+
+// result[i] = input[map[i]]
+template<typename T,
+         typename Size>
+struct gather_functor
+{
+    const T *input;
+    const Size *map;
+    T *result;
+
+    gather_functor(const T *input, const Size *map, T *result)
+      : input(input), map(map), result(result) {}
+
+    void operator()(Size i)
+    {
+        result[i] = input[map[i]];
+    }
+}; // end gather_functor
+
+template<typename T,
+         typename Size>
+struct copy_functor
+{
+    const T *input;
+    T *result;
+
+    copy_functor(const T *input, T *result)
+      : input(input), result(result) {}
+
+    void operator()(Size i)
+    {
+        result[i] = input[i];
+    }
+}; // end copy_functor
+
+// permutes [first, first + n) in place so that first[i] becomes first[map[i]]
+template<typename T,
+         typename Size>
+void permute(T *first, Size n, const Size *map)
+{
+    thrust::detail::raw_threads_device_buffer<T> temp(n);
+    T *raw_temp = thrust::raw_pointer_cast(&*temp.begin());
+
+    parallel_for(n, gather_functor<T,Size>(first, map, raw_temp));
+    parallel_for(n, copy_functor<T,Size>(raw_temp, first));
+} // end permute()
+
+} // end namespace detail
+
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+    if (last - first < 2)
+        return;
+
+    // ensure sequence has trivial iterators
+    thrust::detail::trivial_sequence<RandomAccessIterator> keys(first, last);
+
+    KeyType *raw_first = thrust::raw_pointer_cast(&*keys.begin());
+    KeyType *raw_last  = raw_first + (last - first);
+
+    thrust::detail::raw_threads_device_buffer<KeyType> buffer(last - first);
+
+    detail::stable_merge_sort(raw_first, raw_last, thrust::raw_pointer_cast(&*buffer.begin()), comp);
+
+    // copy results back, if necessary
+    if(!thrust::detail::is_trivial_iterator<RandomAccessIterator>::value)
+        thrust::copy(keys.begin(), keys.end(), first);
+}
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp)
+{
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+    typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+    typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+
+    difference_type n = keys_last - keys_first;
+
+    if (n < 2)
+        return;
+
+    // ensure sequences have trivial iterators
+    RandomAccessIterator2 values_last = values_first + n;
+    thrust::detail::trivial_sequence<RandomAccessIterator1> keys(keys_first, keys_last);
+    thrust::detail::trivial_sequence<RandomAccessIterator2> values(values_first, values_last);
+
+    KeyType   *raw_keys   = thrust::raw_pointer_cast(&*keys.begin());
+    ValueType *raw_values = thrust::raw_pointer_cast(&*values.begin());
+
+    // sort the sequence 0, 1, ..., n - 1 by key
+    thrust::detail::raw_threads_device_buffer<difference_type> permutation(2 * n);
+    difference_type *raw_permutation = thrust::raw_pointer_cast(&*permutation.begin());
+
+    detail::parallel_for(n, detail::sequence_functor<difference_type>(raw_permutation));
+
+    detail::stable_merge_sort(raw_permutation, raw_permutation + n, raw_permutation + n,
+                              detail::indirect_comp<KeyType,StrictWeakOrdering>(raw_keys, comp));
+
+    detail::permute(raw_keys,   n, raw_permutation);
+    detail::permute(raw_values, n, raw_permutation);
+
+    // copy results back, if necessary
+    if(!thrust::detail::is_trivial_iterator<RandomAccessIterator1>::value)
+        thrust::copy(keys.begin(), keys.end(), keys_first);
+    if(!thrust::detail::is_trivial_iterator<RandomAccessIterator2>::value)
+        thrust::copy(values.begin(), values.end(), values_first);
+}
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
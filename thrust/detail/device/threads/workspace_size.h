@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file workspace_size.h
+ *  \brief The workspace required by the temporaries of std::thread algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/workspace.h>
+#include <thrust/detail/device/threads/detail/parallel_for.h>
+#include <algorithm>
+#include <cstddef>
+
+/*
+ *  Each function below mirrors the raw_buffer allocations of the
+ *  corresponding std::thread algorithm applied to trivial iterators and
+ *  returns the largest number of workspace bytes those temporaries occupy
+ *  at once.
+ */
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+
+// block_sums of inclusive_scan and exclusive_scan
+template<typename T>
+std::size_t scan_workspace_bytes(std::size_t n)
+{
+    if (n == 0)
+        return 0;
+
+    std::ptrdiff_t block_size = detail::default_grain_size(std::ptrdiff_t(n));
+    std::ptrdiff_t num_blocks = (std::ptrdiff_t(n) + block_size - 1) / block_size;
+
+    return workspace_bytes(num_blocks * sizeof(T));
+}
+
+// the permutation of stable_sort_by_key, then the temporary of each permute
+template<typename KeyType,
+         typename ValueType,
+         typename StrictWeakOrdering>
+std::size_t stable_sort_by_key_workspace_bytes(std::size_t n)
+{
+    if (n < 2)
+        return 0;
+
+    return workspace_bytes(2 * n * sizeof(std::ptrdiff_t)) +
+           std::max(workspace_bytes(n * sizeof(KeyType)),
+                    workspace_bytes(n * sizeof(ValueType)));
+}
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -21,7 +21,9 @@
 
 #pragma once
 
+#include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/generic/unique.h>
+#include <thrust/detail/device/dispatch/unique.h>
 
 namespace thrust
 {
@@ -36,7 +38,9 @@ ForwardIterator unique(ForwardIterator first,
                        ForwardIterator last,
                        BinaryPredicate binary_pred)
 {
-    return thrust::detail::device::generic::unique(first, last, binary_pred);
+    // dispatch on the space of the input
+    return thrust::detail::device::dispatch::unique(first, last, binary_pred,
+        typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template <typename InputIterator,
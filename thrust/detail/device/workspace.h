@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file workspace.h
+ *  \brief A caller-provided region from which algorithm temporaries
+ *         are carved instead of being allocated.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/device_ptr.h>
+#include <thrust/detail/device/temporary_cache.h>
+#include <cstddef>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+
+// every temporary carved from a workspace begins at a multiple of
+// workspace_alignment bytes from the beginning of the region
+const std::size_t workspace_alignment = 256;
+
+// the number of bytes of workspace a temporary of num_bytes occupies
+inline std::size_t workspace_bytes(std::size_t num_bytes)
+{
+  return (num_bytes + workspace_alignment - 1) / workspace_alignment * workspace_alignment;
+} // end workspace_bytes()
+
+#if __THRUST_HAS_TEMPORARY_CACHE
+
+// workspace is a stack allocator over a fixed region of device memory.
+// While a workspace is installed on a thread, caching_allocator serves the
+// temporaries of that thread from it.  Temporaries are released in the
+// reverse order of their allocation, which is the order in which raw_buffers
+// go out of scope; a block released out of order is not reused.
+class workspace
+{
+  public:
+    workspace(thrust::device_ptr<void> ptr, std::size_t num_bytes);
+
+    // throws std::bad_alloc when the region cannot hold num_bytes more
+    thrust::device_ptr<void> allocate(std::size_t num_bytes);
+
+    void deallocate(thrust::device_ptr<void> ptr, std::size_t num_bytes) throw();
+
+    bool owns(thrust::device_ptr<void> ptr) const;
+
+    std::size_t size() const;
+
+    std::size_t bytes_in_use() const;
+
+    std::size_t high_water_mark() const;
+
+    // the innermost workspace installed on the calling thread, or 0
+    static workspace *current();
+
+    // the workspace installed on the calling thread which owns ptr, or 0
+    static workspace *owner(thrust::device_ptr<void> ptr);
+
+    // installs this workspace on the calling thread
+    void push();
+
+    // reinstalls the workspace which was current before push()
+    void pop();
+
+  private:
+    static workspace *&current_reference();
+
+    char *m_begin;
+    std::size_t m_size;
+    std::size_t m_top;
+    std::size_t m_high_water_mark;
+    workspace *m_previous;
+
+    // disallow copy and assignment
+    workspace(const workspace &);
+    workspace &operator=(const workspace &);
+}; // end workspace
+
+#endif // __THRUST_HAS_TEMPORARY_CACHE
+
+} // end device
+} // end detail
+} // end thrust
+
+#include <thrust/detail/device/workspace.inl>
+
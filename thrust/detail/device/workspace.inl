@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file workspace.inl
+ *  \brief Inline file for workspace.h.
+ */
+
+#include <thrust/detail/device/workspace.h>
+
+#if __THRUST_HAS_TEMPORARY_CACHE
+
+#include <algorithm>
+#include <new>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+
+
+inline workspace::workspace(thrust::device_ptr<void> ptr, std::size_t num_bytes)
+  : m_begin(static_cast<char*>(ptr.get())),
+    m_size(num_bytes),
+    m_top(0),
+    m_high_water_mark(0),
+    m_previous(0)
+{}
+
+
+inline thrust::device_ptr<void> workspace::allocate(std::size_t num_bytes)
+{
+  const std::size_t block_size = workspace_bytes(num_bytes);
+
+  if(block_size < num_bytes || block_size > m_size - m_top)
+    throw std::bad_alloc();
+
+  void *result = m_begin + m_top;
+
+  m_top += block_size;
+  m_high_water_mark = std::max(m_high_water_mark, m_top);
+
+  return thrust::device_ptr<void>(result);
+} // end workspace::allocate()
+
+
+inline void workspace::deallocate(thrust::device_ptr<void> ptr, std::size_t num_bytes) throw()
+{
+  char *block = static_cast<char*>(ptr.get());
+
+  // only the topmost block can be popped
+  if(block + workspace_bytes(num_bytes) == m_begin + m_top)
+    m_top = block - m_begin;
+} // end workspace::deallocate()
+
+
+inline bool workspace::owns(thrust::device_ptr<void> ptr) const
+{
+  const char *block = static_cast<const char*>(ptr.get());
+
+  return m_begin <= block && block < m_begin + m_size;
+} // end workspace::owns()
+
+
+inline std::size_t workspace::size() const
+{
+  return m_size;
+} // end workspace::size()
+
+
+inline std::size_t workspace::bytes_in_use() const
+{
+  return m_top;
+} // end workspace::bytes_in_use()
+
+
+inline std::size_t workspace::high_water_mark() const
+{
+  return m_high_water_mark;
+} // end workspace::high_water_mark()
+
+
+inline workspace *&workspace::current_reference()
+{
+  static thread_local workspace *current = 0;
+  return current;
+} // end workspace::current_reference()
+
+
+inline workspace *workspace::current()
+{
+  return current_reference();
+} // end workspace::current()
+
+
+inline workspace *workspace::owner(thrust::device_ptr<void> ptr)
+{
+  workspace *result = current_reference();
+
+  while(result != 0 && !result->owns(ptr))
+    result = result->m_previous;
+
+  return result;
+} // end workspace::owner()
+
+
+inline void workspace::push()
+{
+  m_previous = current_reference();
+  current_reference() = this;
+} // end workspace::push()
+
+
+inline void workspace::pop()
+{
+  current_reference() = m_previous;
+  m_previous = 0;
+} // end workspace::pop()
+
+
+} // end device
+} // end detail
+} // end thrust
+
+#endif // __THRUST_HAS_TEMPORARY_CACHE
+
@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file workspace_size.h
+ *  \brief The workspace required by the temporaries of device algorithms
+ *         on the configured backend.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/generic/workspace_size.h>
+
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+#include <thrust/detail/device/omp/workspace_size.h>
+#elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+#include <thrust/detail/device/threads/workspace_size.h>
+#endif // THRUST_DEVICE_BACKEND
+
+// CUDA temporaries are never carved from a workspace, so every function
+// below returns zero with the CUDA backend
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+
+template<typename T>
+std::size_t scan_workspace_bytes(std::size_t n)
+{
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+    return thrust::detail::device::omp::scan_workspace_bytes<T>(n);
+#elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+    return thrust::detail::device::threads::scan_workspace_bytes<T>(n);
+#else
+    return 0;
+#endif // THRUST_DEVICE_BACKEND
+}
+
+inline std::size_t copy_if_workspace_bytes(std::size_t n)
+{
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+    return thrust::detail::device::omp::copy_if_workspace_bytes(n);
+#elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+    return thrust::detail::device::generic::copy_if_workspace_bytes(n);
+#else
+    return 0;
+#endif // THRUST_DEVICE_BACKEND
+}
+
+template<typename ValueType>
+std::size_t reduce_by_key_workspace_bytes(std::size_t n)
+{
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+    return thrust::detail::device::omp::reduce_by_key_workspace_bytes<ValueType>(n);
+#elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+    return thrust::detail::device::generic::reduce_by_key_workspace_bytes<ValueType>(n);
+#else
+    return 0;
+#endif // THRUST_DEVICE_BACKEND
+}
+
+template<typename KeyType,
+         typename ValueType,
+         typename StrictWeakOrdering>
+std::size_t stable_sort_by_key_workspace_bytes(std::size_t n)
+{
+#if THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
+    return thrust::detail::device::omp::stable_sort_by_key_workspace_bytes<KeyType,ValueType,StrictWeakOrdering>(n);
+#elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+    return thrust::detail::device::threads::stable_sort_by_key_workspace_bytes<KeyType,ValueType,StrictWeakOrdering>(n);
+#else
+    return 0;
+#endif // THRUST_DEVICE_BACKEND
+}
+
+template<typename KeyType,
+         typename ValueType>
+std::size_t unique_by_key_workspace_bytes(std::size_t n)
+{
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+    return thrust::detail::device::generic::unique_by_key_workspace_bytes<KeyType,ValueType>(n);
+#else
+    return 0;
+#endif // THRUST_DEVICE_BACKEND
+}
+
+template<typename OutputType>
+std::size_t inclusive_segmented_scan_workspace_bytes(std::size_t n)
+{
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+    return thrust::detail::device::generic::inclusive_segmented_scan_workspace_bytes<OutputType>(n);
+#else
+    return 0;
+#endif // THRUST_DEVICE_BACKEND
+}
+
+template<typename OutputType>
+std::size_t exclusive_segmented_scan_workspace_bytes(std::size_t n)
+{
+#if THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA
+    return thrust::detail::device::generic::exclusive_segmented_scan_workspace_bytes<OutputType>(n);
+#else
+    return 0;
+#endif // THRUST_DEVICE_BACKEND
+}
+
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
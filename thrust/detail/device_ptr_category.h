@@ -29,6 +29,8 @@ namespace detail
 typedef thrust::detail::random_access_cuda_device_iterator_tag device_ptr_category;
 #elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
 typedef thrust::detail::random_access_omp_device_iterator_tag device_ptr_category;
+#elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+typedef thrust::detail::random_access_threads_device_iterator_tag device_ptr_category;
 #else
 #error "Unknown device backend."
 #endif // THRUST_DEVICE_BACKEND
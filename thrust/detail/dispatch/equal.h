@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file equal.h
+ *  \brief Dispatch layer of the equal function.
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_categories.h>
+#include <thrust/iterator/detail/backend_iterator_spaces.h>
+#include <thrust/functional.h>
+#include <thrust/inner_product.h>
+#include <thrust/mismatch.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace dispatch
+{
+
+//////////////////
+// Generic Path //
+//////////////////
+template <typename InputIterator1, typename InputIterator2, typename BinaryPredicate,
+          typename Space1, typename Space2>
+bool equal(InputIterator1 first1, InputIterator1 last1,
+           InputIterator2 first2, BinaryPredicate binary_pred,
+           Space1,
+           Space2)
+{
+    thrust::logical_and<bool> binary_op1; // the "plus" of the inner_product
+    return thrust::inner_product(first1, last1, first2, true, binary_op1, binary_pred);
+}
+
+
+/////////////////
+// OpenMP Path //
+/////////////////
+template <typename InputIterator1, typename InputIterator2, typename BinaryPredicate>
+bool equal(InputIterator1 first1, InputIterator1 last1,
+           InputIterator2 first2, BinaryPredicate binary_pred,
+           thrust::detail::omp_device_space_tag,
+           thrust::detail::omp_device_space_tag)
+{
+    // the OpenMP find_if behind mismatch stops at the first difference,
+    // rather than visiting every element
+    return thrust::mismatch(first1, last1, first2, binary_pred).first == last1;
+}
+
+} // end namespace dispatch
+} // end namespace detail
+} // end namespace thrust
+
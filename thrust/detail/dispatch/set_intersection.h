@@ -65,6 +65,62 @@ template<typename InputIterator1,
 } // end set_intersection()
 
 
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_intersection_by_key(InputIterator1 keys_first1,
+                            InputIterator1 keys_last1,
+                            InputIterator2 keys_first2,
+                            InputIterator2 keys_last2,
+                            InputIterator3 values_first1,
+                            InputIterator4 values_first2,
+                            OutputIterator1 keys_result,
+                            OutputIterator2 values_result,
+                            StrictWeakOrdering comp,
+                            thrust::host_space_tag,
+                            thrust::host_space_tag,
+                            thrust::host_space_tag,
+                            thrust::host_space_tag,
+                            thrust::host_space_tag,
+                            thrust::host_space_tag)
+{
+  return thrust::detail::host::set_intersection_by_key(keys_first1,keys_last1,keys_first2,keys_last2,values_first1,values_first2,keys_result,values_result,comp);
+} // end set_intersection_by_key()
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_intersection_by_key(InputIterator1 keys_first1,
+                            InputIterator1 keys_last1,
+                            InputIterator2 keys_first2,
+                            InputIterator2 keys_last2,
+                            InputIterator3 values_first1,
+                            InputIterator4 values_first2,
+                            OutputIterator1 keys_result,
+                            OutputIterator2 values_result,
+                            StrictWeakOrdering comp,
+                            thrust::device_space_tag,
+                            thrust::device_space_tag,
+                            thrust::device_space_tag,
+                            thrust::device_space_tag,
+                            thrust::device_space_tag,
+                            thrust::device_space_tag)
+{
+  return thrust::detail::device::set_intersection_by_key(keys_first1,keys_last1,keys_first2,keys_last2,values_first1,values_first2,keys_result,values_result,comp);
+} // end set_intersection_by_key()
+
+
 } // end dispatch
 
 } // end detail
@@ -19,9 +19,9 @@
  *  \brief Inline file for equal.h.
  */
 
-#include <thrust/inner_product.h>
-#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/internal_functional.h>
+#include <thrust/detail/dispatch/equal.h>
 
 namespace thrust
 {
@@ -40,8 +40,9 @@ template <typename InputIterator1, typename InputIterator2,
 bool equal(InputIterator1 first1, InputIterator1 last1,
            InputIterator2 first2, BinaryPredicate binary_pred)
 {
-    thrust::logical_and<bool> binary_op1; // the "plus" of the inner_product
-    return thrust::inner_product(first1, last1, first2, true, binary_op1, binary_pred);
+    return thrust::detail::dispatch::equal(first1, last1, first2, binary_pred,
+            typename thrust::iterator_space<InputIterator1>::type(),
+            typename thrust::iterator_space<InputIterator2>::type());
 }
 
 } // end namespace thrust
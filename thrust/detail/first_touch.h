@@ -0,0 +1,49 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file first_touch.h
+ *  \brief Defines the interface to a function which places
+ *         newly allocated storage before it is initialized.
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/dispatch/first_touch.h>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+// touches the uninitialized storage [first, first + n) in the pattern in
+// which parallel algorithms will later access it, so that a first-touch
+// NUMA policy places each page near the thread which processes it
+template<typename RandomAccessIterator,
+         typename Size>
+  void first_touch(RandomAccessIterator first,
+                   Size n)
+{
+  thrust::detail::dispatch::first_touch(first, n,
+    typename thrust::iterator_space<RandomAccessIterator>::type());
+} // end first_touch()
+
+} // end detail
+
+} // end thrust
+
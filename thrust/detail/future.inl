@@ -0,0 +1,259 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file future.inl
+ *  \brief Inline file for future.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/threads/detail/thread_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+// a task of an asynchronous operation, which learns how many operations
+// were queued or executing when it was queued, so that the operations
+// may divide the processors among themselves
+class async_task_base
+  : public thrust::detail::device::threads::detail::task
+{
+  public:
+    async_task_base(void)
+      : m_num_runnable(1)
+    {}
+
+  protected:
+    // the number of operations queued or executing, this one included,
+    // when this one was queued
+    int m_num_runnable;
+
+    // an operation calls finished() once it no longer executes
+    static void finished(void)
+    {
+      --num_runnable();
+    }
+
+  private:
+    static std::atomic<int> &num_runnable(void)
+    {
+      static std::atomic<int> n(0);
+      return n;
+    }
+
+    friend class async_state;
+}; // end async_task_base
+
+
+// the shared state of an asynchronous operation
+class async_state
+{
+  private:
+    typedef thrust::detail::device::threads::detail::thread_pool thread_pool;
+
+  public:
+    async_state(void)
+      : m_ready(false)
+    {}
+
+    virtual ~async_state(void) {}
+
+    bool ready(void) const
+    {
+      return m_ready.load();
+    }
+
+    // blocks until the operation has completed, executing other
+    // pending operations in the meantime
+    void wait(void)
+    {
+      thread_pool &pool = thread_pool::instance();
+
+      while(!ready())
+      {
+        if(!pool.run_pending_task())
+        {
+          // nothing to help with; sleep until the operation completes,
+          // checking for new work periodically
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_completed.wait_for(lock, std::chrono::milliseconds(1));
+        }
+      }
+    }
+
+    void rethrow_if_failed(void) const
+    {
+      if(m_exception) std::rethrow_exception(m_exception);
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+      m_exception = e;
+    }
+
+    void set_ready(void)
+    {
+      std::vector<async_task_base *> continuations;
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ready = true;
+        continuations.swap(m_continuations);
+        m_completed.notify_all();
+      }
+
+      submit(continuations);
+    }
+
+    // submits t to the thread pool once the operation tracked by dependency
+    // has completed.  tasks are never queued before their dependencies
+    // complete, so a thread which executes other tasks while it waits can
+    // never pick up a task which waits upon the waiting thread
+    static void submit_after(const thrust::event &dependency, async_task_base *t)
+    {
+      if(dependency.m_state)
+      {
+        async_state &state = *dependency.m_state;
+
+        std::lock_guard<std::mutex> lock(state.m_mutex);
+
+        if(!state.m_ready)
+        {
+          state.m_continuations.push_back(t);
+          return;
+        }
+      }
+
+      submit(std::vector<async_task_base *>(1, t));
+    }
+
+    static thrust::event make_event(const std::shared_ptr<async_state> &state)
+    {
+      return thrust::event(state);
+    }
+
+  private:
+    // queues tasks which became runnable together, so that each of them
+    // counts all the others
+    static void submit(const std::vector<async_task_base *> &tasks)
+    {
+      if(tasks.empty()) return;
+
+      int num_runnable = async_task_base::num_runnable() += static_cast<int>(tasks.size());
+
+      for(size_t i = 0; i < tasks.size(); ++i)
+      {
+        tasks[i]->m_num_runnable = num_runnable;
+        thread_pool::instance().submit(tasks[i]);
+      }
+    }
+
+    std::atomic<bool>       m_ready;
+    std::mutex              m_mutex;
+    std::condition_variable m_completed;
+    std::exception_ptr      m_exception;
+
+    // tasks to submit upon completion
+    std::vector<async_task_base *> m_continuations;
+}; // end async_state
+
+
+// the shared state of an asynchronous operation which produces a T
+template<typename T>
+  class async_value_state
+    : public async_state
+{
+  public:
+    void set_value(const T &value)
+    {
+      m_value.reset(new T(value));
+    }
+
+    const T &value(void) const
+    {
+      return *m_value;
+    }
+
+    static thrust::future<T> make_future(const std::shared_ptr<async_value_state> &state)
+    {
+      return thrust::future<T>(state);
+    }
+
+  private:
+    std::unique_ptr<T> m_value;
+}; // end async_value_state
+
+} // end detail
+
+
+inline event
+  ::event(void)
+{
+  // a null state denotes an event which is already complete
+} // end event::event()
+
+inline event
+  ::event(const std::shared_ptr<detail::async_state> &state)
+    : m_state(state)
+{
+} // end event::event()
+
+inline bool event
+  ::ready(void) const
+{
+  return !m_state || m_state->ready();
+} // end event::ready()
+
+inline void event
+  ::wait(void) const
+{
+  if(m_state)
+  {
+    m_state->wait();
+    m_state->rethrow_if_failed();
+  }
+} // end event::wait()
+
+
+template<typename T>
+  future<T>
+    ::future(const std::shared_ptr<detail::async_value_state<T> > &state)
+      : event(state)
+{
+} // end future::future()
+
+template<typename T>
+  T future<T>
+    ::get(void) const
+{
+  wait();
+
+  return static_cast<const detail::async_value_state<T>&>(*m_state).value();
+} // end future::get()
+
+} // end thrust
+
@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file set_operation.h
+ *  \brief Serial implementation of the set operations on key-value pairs.
+ */
+
+#pragma once
+
+#include <thrust/pair.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace host
+{
+namespace detail
+{
+
+// Each set operation is described by which elements it keeps while the two
+// sorted ranges are walked in lockstep: elements of the first range less
+// than the current element of the second, elements of the second range less
+// than the current element of the first, and pairs of equivalent elements
+// (of which the element of the first range is kept).
+
+struct set_union_policy
+{
+  static const bool keep_first_only  = true;
+  static const bool keep_second_only = true;
+  static const bool keep_both        = true;
+};
+
+struct set_intersection_policy
+{
+  static const bool keep_first_only  = false;
+  static const bool keep_second_only = false;
+  static const bool keep_both        = true;
+};
+
+struct set_difference_policy
+{
+  static const bool keep_first_only  = true;
+  static const bool keep_second_only = false;
+  static const bool keep_both        = false;
+};
+
+struct set_symmetric_difference_policy
+{
+  static const bool keep_first_only  = true;
+  static const bool keep_second_only = true;
+  static const bool keep_both        = false;
+};
+
+
+template<typename SetOperationPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_operation_by_key(InputIterator1 keys_first1,
+                         InputIterator1 keys_last1,
+                         InputIterator2 keys_first2,
+                         InputIterator2 keys_last2,
+                         InputIterator3 values_first1,
+                         InputIterator4 values_first2,
+                         OutputIterator1 keys_result,
+                         OutputIterator2 values_result,
+                         StrictWeakOrdering comp)
+{
+  while(keys_first1 != keys_last1 && keys_first2 != keys_last2)
+  {
+    if(comp(*keys_first1, *keys_first2))
+    {
+      if(SetOperationPolicy::keep_first_only)
+      {
+        *keys_result = *keys_first1;
+        *values_result = *values_first1;
+        ++keys_result;
+        ++values_result;
+      }
+
+      ++keys_first1;
+      ++values_first1;
+    }
+    else if(comp(*keys_first2, *keys_first1))
+    {
+      if(SetOperationPolicy::keep_second_only)
+      {
+        *keys_result = *keys_first2;
+        *values_result = *values_first2;
+        ++keys_result;
+        ++values_result;
+      }
+
+      ++keys_first2;
+      ++values_first2;
+    }
+    else
+    {
+      if(SetOperationPolicy::keep_both)
+      {
+        *keys_result = *keys_first1;
+        *values_result = *values_first1;
+        ++keys_result;
+        ++values_result;
+      }
+
+      ++keys_first1;
+      ++values_first1;
+      ++keys_first2;
+      ++values_first2;
+    }
+  }
+
+  // whatever remains of either range has no equivalent in the other
+  if(SetOperationPolicy::keep_first_only)
+  {
+    for(; keys_first1 != keys_last1; ++keys_first1, ++values_first1, ++keys_result, ++values_result)
+    {
+      *keys_result = *keys_first1;
+      *values_result = *values_first1;
+    }
+  }
+
+  if(SetOperationPolicy::keep_second_only)
+  {
+    for(; keys_first2 != keys_last2; ++keys_first2, ++values_first2, ++keys_result, ++values_result)
+    {
+      *keys_result = *keys_first2;
+      *values_result = *values_first2;
+    }
+  }
+
+  return thrust::make_pair(keys_result, values_result);
+} // end set_operation_by_key()
+
+} // end detail
+} // end host
+} // end detail
+} // end thrust
+
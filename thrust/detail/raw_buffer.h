@@ -21,6 +21,7 @@
 #pragma once
 
 #include <thrust/detail/device/internal_allocator.h>
+#include <thrust/detail/device/caching_allocator.h>
 #include <thrust/iterator/detail/normal_iterator.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <memory>
@@ -37,6 +38,22 @@ namespace detail
 // forward declaration of normal_iterator
 template<typename> class normal_iterator;
 
+// temporaries in host-addressable device spaces are recycled through the
+// temporary_cache; CUDA temporaries go straight to the device
+template<typename T, typename Space>
+  struct choose_device_raw_buffer_allocator
+#if __THRUST_HAS_TEMPORARY_CACHE && (THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA)
+    : eval_if<
+        is_convertible<Space, thrust::detail::cuda_device_space_tag>::value,
+        identity_< thrust::detail::device::internal_allocator<T> >,
+        identity_< thrust::detail::device::caching_allocator<T> >
+      >
+#else
+    : identity_< thrust::detail::device::internal_allocator<T> >
+#endif
+{};
+
+
 template<typename T, typename Space>
   struct choose_raw_buffer_allocator
     : eval_if<
@@ -51,13 +68,11 @@ template<typename T, typename Space>
 
           identity_< std::allocator<T> >,
 
-          // XXX add backend-specific allocators here?
-
           eval_if<
             // XXX this check is technically incorrect: any could convert to device
             is_convertible<Space, thrust::device_space_tag>::value,
 
-            identity_< thrust::detail::device::internal_allocator<T> >,
+            choose_device_raw_buffer_allocator<T,Space>,
 
             void
           >
@@ -133,6 +148,20 @@ template<typename T>
     raw_omp_device_buffer(InputIterator first, InputIterator last):super_t(first,last){}
 }; // end raw_omp_device_buffer
 
+template<typename T>
+  class raw_threads_device_buffer
+    : public raw_buffer<T, thrust::detail::threads_device_space_tag >
+{
+  private:
+    typedef raw_buffer<T, thrust::detail::threads_device_space_tag > super_t;
+
+  public:
+    explicit raw_threads_device_buffer(typename super_t::size_type n):super_t(n){}
+
+    template<typename InputIterator>
+    raw_threads_device_buffer(InputIterator first, InputIterator last):super_t(first,last){}
+}; // end raw_threads_device_buffer
+
 template<typename T>
   class raw_cuda_device_buffer
     : public raw_buffer<T, thrust::detail::cuda_device_space_tag >
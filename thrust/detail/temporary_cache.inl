@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file temporary_cache.inl
+ *  \brief Inline file for temporary_cache.h.
+ */
+
+#include <thrust/temporary_cache.h>
+#include <thrust/detail/device/temporary_cache.h>
+
+namespace thrust
+{
+
+namespace temporary_cache
+{
+
+#if __THRUST_HAS_TEMPORARY_CACHE && (THRUST_DEVICE_BACKEND != THRUST_DEVICE_BACKEND_CUDA)
+
+void trim(void)
+{
+  thrust::detail::device::temporary_cache::instance().trim();
+} // end trim()
+
+std::size_t limit(void)
+{
+  return thrust::detail::device::temporary_cache::instance().limit();
+} // end limit()
+
+void set_limit(std::size_t num_bytes)
+{
+  thrust::detail::device::temporary_cache::instance().set_limit(num_bytes);
+} // end set_limit()
+
+std::size_t cached_bytes(void)
+{
+  return thrust::detail::device::temporary_cache::instance().cached_bytes();
+} // end cached_bytes()
+
+#else
+
+void trim(void) {}
+
+std::size_t limit(void) { return 0; }
+
+void set_limit(std::size_t) {}
+
+std::size_t cached_bytes(void) { return 0; }
+
+#endif
+
+} // end temporary_cache
+
+} // end thrust
+
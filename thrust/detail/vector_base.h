@@ -25,6 +25,7 @@
 #include <thrust/iterator/detail/normal_iterator.h>
 #include <thrust/iterator/reverse_iterator.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/config.h>
 #include <thrust/detail/type_traits.h>
 #include <thrust/utility.h>
 #include <vector>
@@ -76,6 +77,20 @@ template<typename T, typename Alloc>
      */
     vector_base &operator=(const vector_base &v);
 
+#if __THRUST_HAS_RVALUE_REFERENCES
+    /*! Move constructor takes the storage of an exemplar vector_base,
+     *  leaving it empty.  It allocates and copies nothing.
+     *  \param v The vector_base to move from.
+     */
+    vector_base(vector_base &&v);
+
+    /*! Move assign operator releases the storage of this vector_base and
+     *  takes the storage of an exemplar vector_base, leaving it empty.
+     *  \param v The vector_base to move from.
+     */
+    vector_base &operator=(vector_base &&v);
+#endif // __THRUST_HAS_RVALUE_REFERENCES
+
     /*! Copy constructor copies from an exemplar vector_base with different
      *  type.
      *  \param v The vector_base to copy.
@@ -311,6 +326,21 @@ template<typename T, typename Alloc>
      */
     void swap(vector_base &v);
 
+    /*! This method releases the storage of this vector_base and takes the
+     *  storage of another vector_base, leaving it empty.  No elements are
+     *  allocated, copied or destroyed, so this takes constant time.
+     *
+     *  The other vector_base's allocator must allocate storage which this
+     *  vector_base's allocator may release: either the allocators have the
+     *  same type, or one is \p device_malloc_allocator and the other is
+     *  \p experimental::shared_allocator and the device backend is OpenMP
+     *  or threads.  Otherwise, this method does not compile.
+     *
+     *  \param v The vector_base whose storage to take.
+     */
+    template<typename OtherAlloc>
+    void adopt(vector_base<T,OtherAlloc> &v);
+
     /*! This method removes the element at position pos.
      *  \param pos The position of the element of interest.
      *  \return An iterator pointing to the new location of the element that followed the element
@@ -384,6 +414,9 @@ template<typename T, typename Alloc>
     allocator_type mAllocator;
 
   private:
+    // adopt() takes the storage of vector_bases of other types
+    template<typename OtherT, typename OtherAlloc> friend class vector_base;
+
     // whether or not value_type has a trivial copy constructor
     typedef typename has_trivial_copy_constructor<value_type>::type has_trivial_copy_constructor;
 
@@ -28,6 +28,10 @@
 #include <thrust/distance.h>
 #include <thrust/advance.h>
 #include <thrust/detail/destroy.h>
+#include <thrust/detail/first_touch.h>
+#include <thrust/detail/allocator_shares_storage.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/device_ptr.h>
 #include <thrust/detail/type_traits.h>
 
 #include <algorithm>
@@ -92,6 +96,32 @@ template<typename T, typename Alloc>
   return *this;
 } // end vector_base::operator=()
 
+#if __THRUST_HAS_RVALUE_REFERENCES
+template<typename T, typename Alloc>
+  vector_base<T,Alloc>
+    ::vector_base(vector_base &&v)
+      :mBegin(pointer(static_cast<T*>(0))),
+       mSize(0),
+       mCapacity(0),
+       mAllocator(v.mAllocator)
+{
+  swap(v);
+} // end vector_base::vector_base()
+
+template<typename T, typename Alloc>
+  vector_base<T,Alloc> &
+    vector_base<T,Alloc>
+      ::operator=(vector_base &&v)
+{
+  if(this != &v)
+  {
+    adopt(v);
+  } // end if
+
+  return *this;
+} // end vector_base::operator=()
+#endif // __THRUST_HAS_RVALUE_REFERENCES
+
 template<typename T, typename Alloc>
   template<typename OtherT, typename OtherAlloc>
     vector_base<T,Alloc>
@@ -161,6 +191,8 @@ template<typename T, typename Alloc>
     mBegin = mAllocator.allocate(n);
     mSize = mCapacity = n;
 
+    thrust::detail::first_touch(begin(), n);
+
     thrust::uninitialized_fill(begin(), end(), x);
   } // end if
 } // end vector_base::fill_init()
@@ -518,6 +550,33 @@ template<typename T, typename Alloc>
   thrust::swap(mAllocator, v.mAllocator);
 } // end vector_base::swap()
 
+template<typename T, typename Alloc>
+  template<typename OtherAlloc>
+    void vector_base<T,Alloc>
+      ::adopt(vector_base<T,OtherAlloc> &v)
+{
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X v's storage cannot be released by this vector's allocator.           X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (allocators_share_storage<OtherAlloc,Alloc>::value) );
+
+  if(static_cast<void*>(this) == static_cast<void*>(&v)) return;
+
+  // release our storage
+  thrust::detail::destroy(begin(), end());
+  mAllocator.deallocate(mBegin.base(), capacity());
+
+  // take v's storage
+  mBegin    = iterator(pointer(thrust::raw_pointer_cast(v.mBegin.base())));
+  mSize     = v.mSize;
+  mCapacity = v.mCapacity;
+
+  v.mBegin    = typename vector_base<T,OtherAlloc>::iterator(typename OtherAlloc::pointer(static_cast<T*>(0)));
+  v.mSize     = 0;
+  v.mCapacity = 0;
+} // end vector_base::adopt()
+
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
     ::assign(size_type n, const T &x)
@@ -686,6 +745,10 @@ template<typename T, typename Alloc>
       iterator new_begin = mAllocator.allocate(new_capacity);
       iterator new_end = new_begin;
 
+      // place the new storage as a single range, rather than as the
+      // pieces copied below
+      thrust::detail::first_touch(new_begin, old_size + num_new_elements);
+
       try
       {
         // construct copy elements before the insertion to the beginning of the newly
@@ -801,6 +864,10 @@ template<typename T, typename Alloc>
       iterator new_begin = mAllocator.allocate(new_capacity);
       iterator new_end = new_begin;
 
+      // place the new storage as a single range, rather than as the
+      // pieces copied below
+      thrust::detail::first_touch(new_begin, old_size + n);
+
       try
       {
         // construct copy elements before the insertion to the beginning of the newly
@@ -1005,6 +1072,8 @@ template<typename T, typename Alloc>
 
   new_storage = mAllocator.allocate(allocated_size);
 
+  thrust::detail::first_touch(new_storage, requested_size);
+
   try
   {
     // construct the range to the newly allocated storage
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file workspace.inl
+ *  \brief Inline file for workspace.h.
+ */
+
+#include <thrust/workspace.h>
+#include <thrust/detail/device/workspace_size.h>
+
+namespace thrust
+{
+
+#if __THRUST_HAS_TEMPORARY_CACHE
+
+scoped_workspace
+  ::scoped_workspace(thrust::device_ptr<void> ptr, std::size_t num_bytes)
+    : m_workspace(ptr, num_bytes)
+{
+  m_workspace.push();
+} // end scoped_workspace::scoped_workspace()
+
+scoped_workspace
+  ::~scoped_workspace(void)
+{
+  m_workspace.pop();
+} // end scoped_workspace::~scoped_workspace()
+
+std::size_t scoped_workspace
+  ::size(void) const
+{
+  return m_workspace.size();
+} // end scoped_workspace::size()
+
+std::size_t scoped_workspace
+  ::bytes_in_use(void) const
+{
+  return m_workspace.bytes_in_use();
+} // end scoped_workspace::bytes_in_use()
+
+std::size_t scoped_workspace
+  ::high_water_mark(void) const
+{
+  return m_workspace.high_water_mark();
+} // end scoped_workspace::high_water_mark()
+
+#else
+
+scoped_workspace
+  ::scoped_workspace(thrust::device_ptr<void>, std::size_t num_bytes)
+    : m_size(num_bytes)
+{}
+
+scoped_workspace
+  ::~scoped_workspace(void)
+{}
+
+std::size_t scoped_workspace
+  ::size(void) const
+{
+  return m_size;
+} // end scoped_workspace::size()
+
+std::size_t scoped_workspace
+  ::bytes_in_use(void) const
+{
+  return 0;
+} // end scoped_workspace::bytes_in_use()
+
+std::size_t scoped_workspace
+  ::high_water_mark(void) const
+{
+  return 0;
+} // end scoped_workspace::high_water_mark()
+
+#endif // __THRUST_HAS_TEMPORARY_CACHE
+
+
+template<typename KeyType,
+         typename ValueType>
+  std::size_t sort_by_key_workspace_bytes(std::size_t n)
+{
+  return thrust::sort_by_key_workspace_bytes<KeyType,ValueType>(n, thrust::less<KeyType>());
+} // end sort_by_key_workspace_bytes()
+
+template<typename KeyType,
+         typename ValueType,
+         typename StrictWeakOrdering>
+  std::size_t sort_by_key_workspace_bytes(std::size_t n, StrictWeakOrdering)
+{
+  return thrust::detail::device::stable_sort_by_key_workspace_bytes<KeyType,ValueType,StrictWeakOrdering>(n);
+} // end sort_by_key_workspace_bytes()
+
+template<typename ValueType>
+  std::size_t reduce_by_key_workspace_bytes(std::size_t n)
+{
+  return thrust::detail::device::reduce_by_key_workspace_bytes<ValueType>(n);
+} // end reduce_by_key_workspace_bytes()
+
+std::size_t copy_if_workspace_bytes(std::size_t n)
+{
+  return thrust::detail::device::copy_if_workspace_bytes(n);
+} // end copy_if_workspace_bytes()
+
+template<typename KeyType,
+         typename ValueType>
+  std::size_t unique_by_key_workspace_bytes(std::size_t n)
+{
+  return thrust::detail::device::unique_by_key_workspace_bytes<KeyType,ValueType>(n);
+} // end unique_by_key_workspace_bytes()
+
+namespace experimental
+{
+
+template<typename OutputType>
+  std::size_t inclusive_segmented_scan_workspace_bytes(std::size_t n)
+{
+  return thrust::detail::device::inclusive_segmented_scan_workspace_bytes<OutputType>(n);
+} // end inclusive_segmented_scan_workspace_bytes()
+
+template<typename OutputType>
+  std::size_t exclusive_segmented_scan_workspace_bytes(std::size_t n)
+{
+  return thrust::detail::device::exclusive_segmented_scan_workspace_bytes<OutputType>(n);
+} // end exclusive_segmented_scan_workspace_bytes()
+
+} // end experimental
+
+} // end thrust
+
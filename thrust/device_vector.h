@@ -91,6 +91,31 @@ template<typename T, typename Alloc = thrust::device_malloc_allocator<T> >
     device_vector(const device_vector &v)
       :Parent(v) {}
 
+    /*! Assign operator copies from an exemplar \p device_vector.
+     *  \param v The \p device_vector to copy.
+     */
+    __host__
+    device_vector &operator=(const device_vector &v)
+    { Parent::operator=(v); return *this; }
+
+#if __THRUST_HAS_RVALUE_REFERENCES
+    /*! Move constructor takes the storage of an exemplar \p device_vector,
+     *  leaving it empty.
+     *  \param v The \p device_vector to move from.
+     */
+    __host__
+    device_vector(device_vector &&v)
+      :Parent(static_cast<Parent&&>(v)) {}
+
+    /*! Move assign operator takes the storage of an exemplar \p device_vector,
+     *  leaving it empty.
+     *  \param v The \p device_vector to move from.
+     */
+    __host__
+    device_vector &operator=(device_vector &&v)
+    { Parent::operator=(static_cast<Parent&&>(v)); return *this; }
+#endif // __THRUST_HAS_RVALUE_REFERENCES
+
     /*! Copy constructor copies from an exemplar \p device_vector with different type.
      *  \param v The \p device_vector to copy.
      */
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file execution_config.h
+ *  \brief Controls how the OpenMP backend parallelizes the algorithms
+ *         called by the current thread.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/omp/execution_config.h>
+#include <thrust/detail/device/omp/deterministic.h>
+
+namespace thrust
+{
+
+/*! \p thrust::omp holds the controls of the OpenMP backend.  They are
+ *  set per host thread and have no effect with the other backends.
+ *
+ *  \p execution_config describes the team size, the serial cutoff and the
+ *  schedule of a call, and \p scoped_execution_config installs one for the
+ *  calling thread.  \p scoped_deterministic_reductions makes reductions and
+ *  scans give the same bits for any number of threads.
+ *
+ *  The following code snippet demonstrates how to reduce a small array
+ *  without starting a parallel region, and a large one deterministically
+ *  with two threads.
+ *
+ *  \code
+ *  #include <thrust/execution_config.h>
+ *  #include <thrust/reduce.h>
+ *  #include <thrust/device_vector.h>
+ *  ...
+ *  thrust::omp::execution_config config;
+ *  config.num_threads   = 2;
+ *  config.serial_cutoff = 10000;
+ *
+ *  {
+ *    thrust::omp::scoped_execution_config scope(config);
+ *
+ *    thrust::device_vector<float> small(100, 1);
+ *    thrust::reduce(small.begin(), small.end());  // serial
+ *
+ *    thrust::omp::scoped_deterministic_reductions deterministic;
+ *
+ *    thrust::device_vector<float> large(1 << 20, 1);
+ *    thrust::reduce(large.begin(), large.end());  // two threads
+ *  }
+ *  \endcode
+ */
+namespace omp
+{
+
+using thrust::detail::device::omp::schedule_kind;
+using thrust::detail::device::omp::static_schedule;
+using thrust::detail::device::omp::dynamic_schedule;
+
+using thrust::detail::device::omp::execution_config;
+using thrust::detail::device::omp::current_execution_config;
+using thrust::detail::device::omp::scoped_execution_config;
+
+using thrust::detail::device::omp::deterministic_reductions;
+using thrust::detail::device::omp::set_deterministic_reductions;
+using thrust::detail::device::omp::scoped_deterministic_reductions;
+
+} // end omp
+
+} // end thrust
+
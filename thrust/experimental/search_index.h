@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file search_index.h
+ *  \brief A read-only index for repeated searches of a sorted range.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/device_vector.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+
+namespace experimental
+{
+
+/*! \addtogroup searching
+ *  \{
+ */
+
+/*! \p search_index speeds up repeated searches of a sorted range in device
+ *  memory.  It stores an implicit B+tree whose leaves are the elements of
+ *  the range itself: every level above the leaves holds the first element
+ *  of each node of the level below, and every node holds \p node_size
+ *  elements, which makes a node of \c int exactly one 64-byte cache line.
+ *  A search reads one node per level, with about log<sub>node_size</sub>(n)
+ *  cache misses rather than the log<sub>2</sub>(n) misses of a binary
+ *  search, and counts the elements of each node that precede the value
+ *  without branching on the comparisons.
+ *
+ *  The index stores about <tt>n / (node_size - 1)</tt> elements in addition
+ *  to the range, which it does not copy.  The range must therefore outlive
+ *  the index and must not be modified while the index is used.  Searches
+ *  return positions in the range, as \p lower_bound and \p upper_bound do.
+ *
+ *  The following code snippet demonstrates how to search a range many times.
+ *
+ *  \code
+ *  #include <thrust/experimental/search_index.h>
+ *  #include <thrust/device_vector.h>
+ *  #include <thrust/sort.h>
+ *  ...
+ *  thrust::device_vector<int> events(n);
+ *  thrust::sort(events.begin(), events.end());
+ *
+ *  thrust::experimental::search_index<thrust::device_vector<int>::iterator> index(events.begin(), events.end());
+ *
+ *  thrust::device_vector<int>          queries(m);
+ *  thrust::device_vector<unsigned int> positions(m);
+ *
+ *  // positions[i] is the position in events of the first element not less than queries[i]
+ *  thrust::experimental::lower_bound(index, queries.begin(), queries.end(), positions.begin());
+ *  \endcode
+ *
+ *  \see lower_bound
+ *  \see upper_bound
+ */
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering = thrust::less<typename thrust::iterator_value<RandomAccessIterator>::type> >
+  class search_index
+{
+  public:
+    typedef RandomAccessIterator                                              iterator;
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type      value_type;
+    typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+    typedef StrictWeakOrdering                                                value_compare;
+
+    /*! The number of elements of each node of the tree.
+     */
+    static const int node_size = (64 / sizeof(value_type) > 4) ? int(64 / sizeof(value_type)) : 4;
+
+    /*! This constructor builds the index of a sorted range.
+     *
+     *  \param first The beginning of the range, which is sorted by \p comp.
+     *  \param last The end of the range.
+     *  \param comp The comparison operator the range is sorted by.
+     */
+    search_index(RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp = StrictWeakOrdering());
+
+    /*! \return The beginning of the indexed range.
+     */
+    iterator begin(void) const;
+
+    /*! \return The end of the indexed range.
+     */
+    iterator end(void) const;
+
+    /*! \return The number of elements of the indexed range.
+     */
+    difference_type size(void) const;
+
+    /*! \return The comparison operator the range is sorted by.
+     */
+    value_compare value_comp(void) const;
+
+    /*! Writes the position in the indexed range of the first element not
+     *  less than each value of <tt>[values_first, values_last)</tt> to
+     *  \p output, as \p lower_bound does.
+     *
+     *  \return The end of the output sequence.
+     */
+    template<typename InputIterator, typename OutputIterator>
+    OutputIterator lower_bound(InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator output) const;
+
+    /*! Writes the position in the indexed range of the first element
+     *  greater than each value of <tt>[values_first, values_last)</tt> to
+     *  \p output, as \p upper_bound does.
+     *
+     *  \return The end of the output sequence.
+     */
+    template<typename InputIterator, typename OutputIterator>
+    OutputIterator upper_bound(InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator output) const;
+
+    // a tree of node_size >= 4 elements per node over 2^63 elements has
+    // fewer levels than this
+    static const int max_levels = 32;
+
+  private:
+    template<typename Policy, typename InputIterator, typename OutputIterator>
+    OutputIterator search(InputIterator values_first,
+                          InputIterator values_last,
+                          OutputIterator output) const;
+
+    RandomAccessIterator m_first;
+    difference_type      m_size;
+    StrictWeakOrdering   m_comp;
+
+    // the levels above the leaves, beginning with the root;
+    // every level begins at a multiple of node_size
+    thrust::device_vector<value_type> m_separators;
+
+    int             m_num_levels;
+    difference_type m_level_begin[max_levels];
+    difference_type m_level_size[max_levels];
+}; // end search_index
+
+
+/*! \p lower_bound finds, for each value of <tt>[values_first, values_last)</tt>,
+ *  the position in the range indexed by \p index of the first element which
+ *  is not less than the value.
+ *
+ *  \param index The index of the sorted range to search.
+ *  \param values_first The beginning of the values to search for.
+ *  \param values_last The end of the values to search for.
+ *  \param output The beginning of the output sequence.
+ *  \return The end of the output sequence.
+ *
+ *  \see search_index
+ */
+template<typename RandomAccessIterator, typename StrictWeakOrdering, typename InputIterator, typename OutputIterator>
+OutputIterator lower_bound(const search_index<RandomAccessIterator,StrictWeakOrdering> &index,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output);
+
+/*! \p upper_bound finds, for each value of <tt>[values_first, values_last)</tt>,
+ *  the position in the range indexed by \p index of the first element which
+ *  is greater than the value.
+ *
+ *  \param index The index of the sorted range to search.
+ *  \param values_first The beginning of the values to search for.
+ *  \param values_last The end of the values to search for.
+ *  \param output The beginning of the output sequence.
+ *  \return The end of the output sequence.
+ *
+ *  \see search_index
+ */
+template<typename RandomAccessIterator, typename StrictWeakOrdering, typename InputIterator, typename OutputIterator>
+OutputIterator upper_bound(const search_index<RandomAccessIterator,StrictWeakOrdering> &index,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output);
+
+/*! \}
+ */
+
+} // end experimental
+
+} // end thrust
+
+#include <thrust/experimental/search_index.inl>
+
@@ -0,0 +1,330 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file search_index.inl
+ *  \brief Inline file for search_index.h.
+ */
+
+#include <thrust/experimental/search_index.h>
+#include <thrust/copy.h>
+#include <thrust/for_each.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/detail/device/dereference.h>
+
+namespace thrust
+{
+
+namespace experimental
+{
+
+namespace detail
+{
+
+template<typename Size>
+  struct multiply_by
+    : public thrust::unary_function<Size,Size>
+{
+  Size factor;
+
+  multiply_by(Size factor) : factor(factor) {}
+
+  __host__ __device__
+  Size operator()(Size i) const
+  {
+    return i * factor;
+  }
+}; // end multiply_by
+
+struct lower_bound_policy
+{
+  template<typename Element, typename T, typename StrictWeakOrdering>
+  __host__ __device__
+  static bool precedes(const Element &element, const T &value, StrictWeakOrdering comp)
+  {
+    return comp(element, value);
+  }
+}; // end lower_bound_policy
+
+struct upper_bound_policy
+{
+  template<typename Element, typename T, typename StrictWeakOrdering>
+  __host__ __device__
+  static bool precedes(const Element &element, const T &value, StrictWeakOrdering comp)
+  {
+    return !comp(value, element);
+  }
+}; // end upper_bound_policy
+
+
+// descends the tree for each value: the number of elements of a node which
+// precede the value selects the child whose first element is the last to
+// precede it, and at the leaves that number completes the position
+template<typename Policy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         int NodeSize,
+         int MaxLevels>
+  struct search_index_functor
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+
+  RandomAccessIterator1 first;
+  difference_type       n;
+  RandomAccessIterator2 separators;
+  StrictWeakOrdering    comp;
+  int                   num_levels;
+  difference_type       level_begin[MaxLevels];
+  difference_type       level_size[MaxLevels];
+
+  template<typename RandomAccessIterator, typename T>
+  __host__ __device__
+  difference_type count_preceding(RandomAccessIterator node, difference_type size, const T &value)
+  {
+    difference_type count = 0;
+
+    if (size == NodeSize)
+    {
+      // a full node, which the compiler may unroll
+      for (int i = 0; i < NodeSize; i++)
+        count += Policy::precedes(thrust::detail::device::dereference(node, i), value, comp);
+    }
+    else
+    {
+      for (difference_type i = 0; i < size; i++)
+        count += Policy::precedes(thrust::detail::device::dereference(node, i), value, comp);
+    }
+
+    return count;
+  }
+
+  template<typename T>
+  __host__ __device__
+  difference_type search(const T &value)
+  {
+    difference_type node = 0;
+
+    for (int level = 0; level < num_levels; level++)
+    {
+      difference_type begin = node * NodeSize;
+      difference_type size  = level_size[level] - begin;
+
+      if (size > NodeSize)
+        size = NodeSize;
+
+      difference_type count = count_preceding(separators + (level_begin[level] + begin), size, value);
+
+      node = begin + (count > 0 ? count - 1 : 0);
+    }
+
+    difference_type begin = node * NodeSize;
+    difference_type size  = n - begin;
+
+    if (size > NodeSize)
+      size = NodeSize;
+
+    return begin + count_preceding(first + begin, size, value);
+  }
+
+  template<typename Tuple>
+  __host__ __device__
+  void operator()(Tuple t)
+  {
+    thrust::get<1>(t) = search(thrust::get<0>(t));
+  }
+}; // end search_index_functor
+
+} // end detail
+
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  const int search_index<RandomAccessIterator,StrictWeakOrdering>::node_size;
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  const int search_index<RandomAccessIterator,StrictWeakOrdering>::max_levels;
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  search_index<RandomAccessIterator,StrictWeakOrdering>
+    ::search_index(RandomAccessIterator first,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+      : m_first(first),
+        m_size(thrust::distance(first, last)),
+        m_comp(comp),
+        m_num_levels(0)
+{
+  // size the levels from the leaves up, until one node holds a whole level
+  difference_type sizes[max_levels];
+
+  for (difference_type size = m_size; size > node_size; m_num_levels++)
+  {
+    size = (size + node_size - 1) / node_size;
+    sizes[m_num_levels] = size;
+  }
+
+  // place the levels from the root down
+  difference_type total = 0;
+
+  for (int level = 0; level < m_num_levels; level++)
+  {
+    m_level_size[level]  = sizes[m_num_levels - 1 - level];
+    m_level_begin[level] = total;
+
+    total += (m_level_size[level] + node_size - 1) / node_size * node_size;
+  }
+
+  m_separators.resize(total);
+
+  // fill the levels from the leaves up with the first element of each
+  // node of the level below
+  thrust::counting_iterator<difference_type> counter(0);
+  thrust::transform_iterator<detail::multiply_by<difference_type>, thrust::counting_iterator<difference_type> >
+    node_begin(counter, detail::multiply_by<difference_type>(node_size));
+
+  for (int level = m_num_levels - 1; level >= 0; level--)
+  {
+    typename thrust::device_vector<value_type>::iterator result = m_separators.begin() + m_level_begin[level];
+
+    if (level == m_num_levels - 1)
+    {
+      thrust::copy(thrust::make_permutation_iterator(m_first, node_begin),
+                   thrust::make_permutation_iterator(m_first, node_begin) + m_level_size[level],
+                   result);
+    }
+    else
+    {
+      typename thrust::device_vector<value_type>::iterator below = m_separators.begin() + m_level_begin[level + 1];
+
+      thrust::copy(thrust::make_permutation_iterator(below, node_begin),
+                   thrust::make_permutation_iterator(below, node_begin) + m_level_size[level],
+                   result);
+    }
+  }
+} // end search_index::search_index()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  typename search_index<RandomAccessIterator,StrictWeakOrdering>::iterator
+    search_index<RandomAccessIterator,StrictWeakOrdering>
+      ::begin(void) const
+{
+  return m_first;
+} // end search_index::begin()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  typename search_index<RandomAccessIterator,StrictWeakOrdering>::iterator
+    search_index<RandomAccessIterator,StrictWeakOrdering>
+      ::end(void) const
+{
+  return m_first + m_size;
+} // end search_index::end()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  typename search_index<RandomAccessIterator,StrictWeakOrdering>::difference_type
+    search_index<RandomAccessIterator,StrictWeakOrdering>
+      ::size(void) const
+{
+  return m_size;
+} // end search_index::size()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  typename search_index<RandomAccessIterator,StrictWeakOrdering>::value_compare
+    search_index<RandomAccessIterator,StrictWeakOrdering>
+      ::value_comp(void) const
+{
+  return m_comp;
+} // end search_index::value_comp()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  template<typename InputIterator, typename OutputIterator>
+    OutputIterator search_index<RandomAccessIterator,StrictWeakOrdering>
+      ::lower_bound(InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator output) const
+{
+  return search<detail::lower_bound_policy>(values_first, values_last, output);
+} // end search_index::lower_bound()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  template<typename InputIterator, typename OutputIterator>
+    OutputIterator search_index<RandomAccessIterator,StrictWeakOrdering>
+      ::upper_bound(InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator output) const
+{
+  return search<detail::upper_bound_policy>(values_first, values_last, output);
+} // end search_index::upper_bound()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  template<typename Policy, typename InputIterator, typename OutputIterator>
+    OutputIterator search_index<RandomAccessIterator,StrictWeakOrdering>
+      ::search(InputIterator values_first,
+               InputIterator values_last,
+               OutputIterator output) const
+{
+  typedef typename thrust::device_vector<value_type>::const_iterator separator_iterator;
+
+  detail::search_index_functor<Policy, RandomAccessIterator, separator_iterator, StrictWeakOrdering, node_size, max_levels> f;
+
+  f.first      = m_first;
+  f.n          = m_size;
+  f.separators = m_separators.begin();
+  f.comp       = m_comp;
+  f.num_levels = m_num_levels;
+
+  for (int level = 0; level < m_num_levels; level++)
+  {
+    f.level_begin[level] = m_level_begin[level];
+    f.level_size[level]  = m_level_size[level];
+  }
+
+  difference_type m = thrust::distance(values_first, values_last);
+
+  thrust::for_each(thrust::make_zip_iterator(thrust::make_tuple(values_first, output)),
+                   thrust::make_zip_iterator(thrust::make_tuple(values_last,  output + m)),
+                   f);
+
+  return output + m;
+} // end search_index::search()
+
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering, typename InputIterator, typename OutputIterator>
+OutputIterator lower_bound(const search_index<RandomAccessIterator,StrictWeakOrdering> &index,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output)
+{
+  return index.lower_bound(values_first, values_last, output);
+} // end lower_bound()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering, typename InputIterator, typename OutputIterator>
+OutputIterator upper_bound(const search_index<RandomAccessIterator,StrictWeakOrdering> &index,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output)
+{
+  return index.upper_bound(values_first, values_last, output);
+} // end upper_bound()
+
+} // end experimental
+
+} // end thrust
+
@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file shared_allocator.h
+ *  \brief A host allocator whose storage may be exchanged with device_vector
+ *         on backends where the device is the host.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/generic/malloc.h>
+#include <thrust/detail/device/generic/free.h>
+#include <thrust/device_ptr.h>
+#include <limits>
+#include <stdexcept>
+
+namespace thrust
+{
+
+namespace experimental
+{
+
+/*! \addtogroup memory_management Memory Management
+ *  \addtogroup memory_management_classes
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! \p shared_allocator is a host memory allocator which obtains its storage
+ *  the way \p device_malloc does on the OpenMP and threads backends.  When
+ *  one of those backends is selected, a \p host_vector using
+ *  \p shared_allocator and a \p device_vector using the default allocator
+ *  may take each other's storage with \p adopt, without copying.
+ *
+ *  \code
+ *  #include <thrust/host_vector.h>
+ *  #include <thrust/device_vector.h>
+ *  #include <thrust/experimental/shared_allocator.h>
+ *  ...
+ *  thrust::host_vector<float, thrust::experimental::shared_allocator<float> > h(n);
+ *  read_input(h);
+ *
+ *  thrust::device_vector<float> d;
+ *  d.adopt(h); // d holds the data and h is empty
+ *  thrust::sort(d.begin(), d.end());
+ *
+ *  h.adopt(d); // and back again
+ *  \endcode
+ *
+ *  With the CUDA backend, \p shared_allocator allocates ordinary host memory
+ *  and \p adopt between the two containers is not available.
+ *
+ *  \see http://www.sgi.com/tech/stl/Allocators.html
+ */
+template<typename T>
+  class shared_allocator
+{
+  public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // convert a shared_allocator<T> to shared_allocator<U>
+    template<typename U>
+      struct rebind
+    {
+      typedef shared_allocator<U> other;
+    }; // end rebind
+
+    /*! \p shared_allocator's null constructor does nothing.
+     */
+    __host__ __device__
+    inline shared_allocator() {}
+
+    /*! \p shared_allocator's null destructor does nothing.
+     */
+    __host__ __device__
+    inline ~shared_allocator() {}
+
+    /*! \p shared_allocator's copy constructor does nothing.
+     */
+    __host__ __device__
+    inline shared_allocator(shared_allocator const &) {}
+
+    /*! This version of \p shared_allocator's copy constructor
+     *  is templated on the \c value_type of the \p shared_allocator
+     *  to copy from.  It is provided merely for convenience; it
+     *  does nothing.
+     */
+    template<typename U>
+    __host__ __device__
+    inline shared_allocator(shared_allocator<U> const &) {}
+
+    /*! This method returns the address of a \c reference of
+     *  interest.
+     *
+     *  \p r The \c reference of interest.
+     *  \return \c r's address.
+     */
+    __host__ __device__
+    inline pointer address(reference r) { return &r; }
+
+    /*! This method returns the address of a \c const_reference
+     *  of interest.
+     *
+     *  \p r The \c const_reference of interest.
+     *  \return \c r's address.
+     */
+    __host__ __device__
+    inline const_pointer address(const_reference r) { return &r; }
+
+    /*! This method allocates storage for objects in host memory.
+     *
+     *  \p cnt The number of objects to allocate.
+     *  \return a \c pointer to the newly allocated objects.
+     *  \note This method does not invoke \p value_type's constructor.
+     *        It is the responsibility of the caller to initialize the
+     *        objects at the returned \c pointer. 
+     */
+    __host__
+    inline pointer allocate(size_type cnt,
+                            const_pointer = 0)
+    {
+      if(cnt > this->max_size())
+      {
+        throw std::bad_alloc();
+      } // end if
+
+      thrust::device_ptr<void> result = thrust::detail::device::generic::malloc<0>(cnt * sizeof(value_type));
+
+      return static_cast<pointer>(result.get());
+    } // end allocate()
+
+    /*! This method deallocates host memory previously allocated
+     *  with this \c shared_allocator or, on the OpenMP and threads
+     *  backends, with \p device_malloc.
+     *
+     *  \p p A \c pointer to the previously allocated memory.
+     *  \p cnt The number of objects previously allocated at
+     *         \p p.
+     *  \note This method does not invoke \p value_type's destructor.
+     *        It is the responsibility of the caller to destroy
+     *        the objects stored at \p p.
+     */
+    __host__
+    inline void deallocate(pointer p, size_type cnt)
+    {
+      thrust::detail::device::generic::free<0>(thrust::device_ptr<void>(p));
+    } // end deallocate()
+
+    /*! This method returns the maximum size of the \c cnt parameter
+     *  accepted by the \p allocate() method.
+     *
+     *  \return The maximum number of objects that may be allocated
+     *          by a single call to \p allocate().
+     */
+    inline size_type max_size() const
+    {
+      return std::numeric_limits<size_type>::max() / sizeof(T);
+    } // end max_size()
+
+    /*! This method tests this \p shared_allocator for equality to
+     *  another.
+     *
+     *  \param x The other \p shared_allocator of interest.
+     *  \return This method always returns \c true.
+     */
+    __host__ __device__
+    inline bool operator==(shared_allocator const& x) { return true; }
+
+    /*! This method tests this \p shared_allocator for inequality
+     *  to another.
+     *
+     *  \param x The other \p shared_allocator of interest.
+     *  \return This method always returns \c false.
+     */
+    __host__ __device__
+    inline bool operator!=(shared_allocator const &x) { return !operator==(x); }
+}; // end shared_allocator
+
+/*! \}
+ */
+
+} // end experimental
+
+} // end thrust
+
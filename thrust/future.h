@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file future.h
+ *  \brief Handles to the completion and results of asynchronous algorithms
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/threads/detail/thread_pool.h>
+
+#include <memory>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+class async_state;
+
+template<typename T> class async_value_state;
+
+} // end detail
+
+/*! \addtogroup async
+ *  \{
+ */
+
+/*! \p event tracks the completion of an operation launched by one of the
+ *  algorithms in namespace \p thrust::async.  An \p event may be passed as
+ *  the dependency of a subsequent launch, which then does not begin until the
+ *  first operation has completed.  Copies of an \p event refer to the same
+ *  operation.
+ *
+ *  \see future
+ */
+class event
+{
+  public:
+    /*! This constructor creates an \p event which is already complete.
+     */
+    event(void);
+
+    /*! \return \c true if the operation has completed.
+     */
+    bool ready(void) const;
+
+    /*! Blocks until the operation has completed.  While blocked, the calling
+     *  thread executes other pending asynchronous operations.  If the
+     *  operation exited with an exception, \p wait rethrows it.
+     */
+    void wait(void) const;
+
+  protected:
+    explicit event(const std::shared_ptr<detail::async_state> &state);
+
+    std::shared_ptr<detail::async_state> m_state;
+
+    template<typename> friend class future;
+    friend class detail::async_state;
+}; // end event
+
+
+/*! \p future is an \p event which also carries the result of its operation.
+ *
+ *  \tparam T The type of the result.
+ */
+template<typename T>
+  class future
+    : public event
+{
+  public:
+    /*! Waits for the operation to complete and returns its result.  If the
+     *  operation exited with an exception, \p get rethrows it.
+     */
+    T get(void) const;
+
+  protected:
+    explicit future(const std::shared_ptr<detail::async_value_state<T> > &state);
+
+    friend class detail::async_value_state<T>;
+}; // end future
+
+/*! \} // end async
+ */
+
+} // end thrust
+
+#include <thrust/detail/future.inl>
+
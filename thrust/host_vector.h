@@ -98,6 +98,24 @@ template<typename T, typename Alloc = std::allocator<T> >
     host_vector &operator=(const host_vector &v)
     { Parent::operator=(v); return *this; }
 
+#if __THRUST_HAS_RVALUE_REFERENCES
+    /*! Move constructor takes the storage of an exemplar \p host_vector,
+     *  leaving it empty.
+     *  \param v The \p host_vector to move from.
+     */
+    __host__
+    host_vector(host_vector &&v)
+      :Parent(static_cast<Parent&&>(v)) {}
+
+    /*! Move assign operator takes the storage of an exemplar \p host_vector,
+     *  leaving it empty.
+     *  \param v The \p host_vector to move from.
+     */
+    __host__
+    host_vector &operator=(host_vector &&v)
+    { Parent::operator=(static_cast<Parent&&>(v)); return *this; }
+#endif // __THRUST_HAS_RVALUE_REFERENCES
+
     /*! Copy constructor copies from an exemplar \p host_vector with different type.
      *  \param v The \p host_vector to copy.
      */
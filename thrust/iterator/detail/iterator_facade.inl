@@ -213,6 +213,36 @@ template<typename Traversal, typename ValueParam, typename Reference>
 }; // end iterator_facade_default_category_device
 
 
+// this is the function for threads device space iterators
+template<typename Traversal, typename ValueParam, typename Reference>
+  struct iterator_facade_default_category_threads_device :
+    thrust::detail::eval_if<
+      thrust::detail::and_<
+        thrust::detail::is_device_reference<Reference>,
+        thrust::detail::is_convertible<Traversal, thrust::forward_traversal_tag>
+      >::value,
+      thrust::detail::eval_if<
+        thrust::detail::is_convertible<Traversal, thrust::random_access_traversal_tag>::value,
+        thrust::detail::identity_<thrust::detail::random_access_threads_device_iterator_tag>,
+        thrust::detail::eval_if<
+          thrust::detail::is_convertible<Traversal, thrust::bidirectional_traversal_tag>::value,
+          thrust::detail::identity_<thrust::detail::bidirectional_threads_device_iterator_tag>,
+          thrust::detail::identity_<thrust::detail::forward_threads_device_iterator_tag>
+        >
+      >,
+      thrust::detail::eval_if<
+        thrust::detail::and_<
+          thrust::detail::is_convertible<Traversal, thrust::single_pass_traversal_tag>,
+          thrust::detail::is_convertible<Reference, ValueParam>
+        >::value,
+        thrust::detail::identity_<thrust::detail::input_threads_device_iterator_tag>,
+        thrust::detail::identity_<Traversal>
+      >
+    >
+{
+}; // end iterator_facade_default_category_device
+
+
 // this is the function for any space iterators
 template<typename Traversal, typename ValueParam, typename Reference>
   struct iterator_facade_default_category_any :
@@ -264,18 +294,24 @@ template<typename Space, typename Traversal, typename ValueParam, typename Refer
             thrust::detail::is_convertible<Space, thrust::detail::cuda_device_space_tag>::value,
             iterator_facade_default_category_cuda_device<Traversal, ValueParam, Reference>,
 
-            // check for omp device space
+            // check for threads device space
             thrust::detail::eval_if<
-              thrust::detail::is_convertible<Space, thrust::detail::omp_device_space_tag>::value,
-              iterator_facade_default_category_omp_device<Traversal, ValueParam, Reference>,
+              thrust::detail::is_convertible<Space, thrust::detail::threads_device_space_tag>::value,
+              iterator_facade_default_category_threads_device<Traversal, ValueParam, Reference>,
 
-              // check for device space
+              // check for omp device space
               thrust::detail::eval_if<
-                thrust::detail::is_convertible<Space, thrust::device_space_tag>::value,
-                iterator_facade_default_category_device<Traversal, ValueParam, Reference>,
+                thrust::detail::is_convertible<Space, thrust::detail::omp_device_space_tag>::value,
+                iterator_facade_default_category_omp_device<Traversal, ValueParam, Reference>,
+
+                // check for device space
+                thrust::detail::eval_if<
+                  thrust::detail::is_convertible<Space, thrust::device_space_tag>::value,
+                  iterator_facade_default_category_device<Traversal, ValueParam, Reference>,
 
-                // on failure, return Traversal
-                thrust::detail::identity_<Traversal>
+                  // on failure, return Traversal
+                  thrust::detail::identity_<Traversal>
+                >
               >
             >
           >
@@ -32,6 +32,8 @@ struct input_universal_iterator_tag
   operator thrust::detail::input_cuda_device_iterator_tag () {return thrust::detail::input_cuda_device_iterator_tag();}
 
   operator detail::input_omp_device_iterator_tag () {return detail::input_omp_device_iterator_tag();}
+
+  operator detail::input_threads_device_iterator_tag () {return detail::input_threads_device_iterator_tag();}
 };
 
 struct output_universal_iterator_tag
@@ -41,6 +43,8 @@ struct output_universal_iterator_tag
   operator detail::output_cuda_device_iterator_tag () {return detail::output_cuda_device_iterator_tag();}
 
   operator detail::output_omp_device_iterator_tag () {return detail::output_omp_device_iterator_tag();}
+
+  operator detail::output_threads_device_iterator_tag () {return detail::output_threads_device_iterator_tag();}
 };
 
 struct forward_universal_iterator_tag
@@ -51,6 +55,8 @@ struct forward_universal_iterator_tag
   operator detail::forward_cuda_device_iterator_tag () {return detail::forward_cuda_device_iterator_tag();};
 
   operator detail::forward_omp_device_iterator_tag () {return detail::forward_omp_device_iterator_tag();};
+
+  operator detail::forward_threads_device_iterator_tag () {return detail::forward_threads_device_iterator_tag();};
 };
 
 struct bidirectional_universal_iterator_tag
@@ -61,6 +67,8 @@ struct bidirectional_universal_iterator_tag
   operator detail::bidirectional_cuda_device_iterator_tag () {return detail::bidirectional_cuda_device_iterator_tag();};
 
   operator detail::bidirectional_omp_device_iterator_tag () {return detail::bidirectional_omp_device_iterator_tag();};
+
+  operator detail::bidirectional_threads_device_iterator_tag () {return detail::bidirectional_threads_device_iterator_tag();};
 };
 
 
@@ -88,6 +96,8 @@ struct random_access_universal_iterator_tag
 
   operator detail::random_access_omp_device_iterator_tag () {return detail::random_access_omp_device_iterator_tag();};
 
+  operator detail::random_access_threads_device_iterator_tag () {return detail::random_access_threads_device_iterator_tag();};
+
   // bidirectional_universal_iterator_tag is P1
   operator detail::one_degree_of_separation<bidirectional_universal_iterator_tag> () {return detail::one_degree_of_separation<bidirectional_universal_iterator_tag>();}
 
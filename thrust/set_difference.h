@@ -0,0 +1,241 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file set_difference.h
+ *  \brief Set difference for sorted ranges.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/pair.h>
+
+namespace thrust
+{
+
+/*! \addtogroup set_operations Set Operations
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \p set_difference constructs a sorted range that is the set
+ *  difference of the sorted ranges <tt>[first1, last1)</tt> and
+ *  <tt>[first2, last2)</tt>. The return value is the end of the output
+ *  range.
+ *
+ *  In the simplest case, \p set_difference performs the "difference"
+ *  operation from set theory: the output range contains a copy of every
+ *  element that is contained in <tt>[first1, last1)</tt> and not contained
+ *  in <tt>[first2, last2)</tt>. The general case is more complicated,
+ *  because the input ranges may contain duplicate elements. The
+ *  generalization is that if a value appears \c m times in
+ *  <tt>[first1, last1)</tt> and \c n times in <tt>[first2, last2)</tt>
+ *  (where \c m or \c n may be zero), then the last <tt>max(m-n,0)</tt>
+ *  copies of it in <tt>[first1, last1)</tt> are copied to the output
+ *  range. \p set_difference is stable, meaning that the relative order of
+ *  elements in the output range is the same as in the first input range.
+ *
+ *  This version of \p set_difference compares objects using
+ *  \c operator<.
+ *
+ *  \param first1 The beginning of the first input range.
+ *  \param last1 The end of the first input range.
+ *  \param first2 The beginning of the second input range.
+ *  \param last2 The end of the second input range.
+ *  \param result The beginning of the output range.
+ *  \return The end of the output range.
+ *
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator1 and \p InputIterator2 have the same \c value_type,
+ *          \p InputIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a>,
+ *          the ordering on \p InputIterator1's \c value_type is a strict weak ordering, as defined in the <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a> requirements,
+ *          and \p InputIterator1's \c value_type is convertable to a type in \p OutputIterator's set of \c value_types.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator2 and \p InputIterator1 have the same \c value_type,
+ *          \p InputIterator2's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a>,
+ *          the ordering on \p InputIterator2's \c value_type is a strict weak ordering, as defined in the <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a> requirements,
+ *          and \p InputIterator2's \c value_type is convertable to a type in \p OutputIterator's set of \c value_types.
+ *  \tparam OutputIterator is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>.
+ *
+ *  The following code snippet demonstrates how to use
+ *  \p set_difference to compute the difference of two sorted
+ *  sets of integers.
+ *
+ *  \code
+ *  #include <thrust/set_difference.h>
+ *  ...
+ *  int A1[6] = {1, 3, 5, 7, 9, 11};
+ *  int A2[7] = {1, 1, 2, 3, 5,  8, 13};
+ *
+ *  int result[6];
+ *
+ *  int *result_end = thrust::set_difference(A1, A1 + 6, A2, A2 + 7, result);
+ *  // result[0] = 7
+ *  // result[1] = 9
+ *  // result[2] = 11
+ *  // values beyond result[2] are undefined
+ *  \endcode
+ *
+ *  \see http://www.sgi.com/tech/stl/set_difference.html
+ *  \see \p sort
+ *  \see \p is_sorted
+ */
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator>
+  OutputIterator set_difference(InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result);
+
+
+/*! This version of \p set_difference is identical to the first, except
+ *  that it compares objects using the function object \p comp.
+ *
+ *  \param first1 The beginning of the first input range.
+ *  \param last1 The end of the first input range.
+ *  \param first2 The beginning of the second input range.
+ *  \param last2 The end of the second input range.
+ *  \param result The beginning of the output range.
+ *  \param comp Comparison operator.
+ *  \return The end of the output range.
+ *
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator1 and \p InputIterator2 have the same \c value_type,
+ *          \p InputIterator1's \c value_type is convertable to \p StrictWeakOrdering's \c first_argument_type
+ *          and to a type in \p OutputIterator's set of \c value_types.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator2 and \p InputIterator1 have the same \c value_type,
+ *          \p InputIterator2's \c value_type is convertable to \p StrictWeakOrdering's \c second_argument_type
+ *          and to a type in \p OutputIterator's set of \c value_types.
+ *  \tparam OutputIterator is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>.
+ *  \tparam StrictWeakOrdering is a model of <a href="http://www.sgi.com/tech/stl/StrictWeakOrdering.html">Strict Weak Ordering</a>.
+ *
+ *  \see \p set_difference
+ */
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_difference(InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp);
+
+
+/*! \p set_difference_by_key is a generalization of \p set_difference to key-value pairs.
+ *  It computes the difference of the sorted ranges of keys
+ *  <tt>[keys_first1, keys_last1)</tt> and <tt>[keys_first2, keys_last2)</tt>
+ *  exactly as \p set_difference does, and copies the value corresponding to each
+ *  output key to the output range of values.  Every key copied from the first
+ *  range of keys is accompanied by its value from <tt>[values_first1, ...)</tt>
+ *  and every key copied from the second range by its value from
+ *  <tt>[values_first2, ...)</tt>.
+ *
+ *  This version of \p set_difference_by_key compares keys using \c operator<.
+ *
+ *  \param keys_first1 The beginning of the first input range of keys.
+ *  \param keys_last1 The end of the first input range of keys.
+ *  \param keys_first2 The beginning of the second input range of keys.
+ *  \param keys_last2 The end of the second input range of keys.
+ *  \param values_first1 The beginning of the values corresponding to the first range of keys.
+ *  \param values_first2 The beginning of the values corresponding to the second range of keys.
+ *  \param keys_result The beginning of the output range of keys.
+ *  \param values_result The beginning of the output range of values.
+ *  \return A \p pair \c p such that <tt>p.first</tt> is the end of the output range of keys
+ *          and <tt>p.second</tt> is the end of the output range of values.
+ *
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator1 and \p InputIterator2 have the same \c value_type,
+ *          \p InputIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a>,
+ *          and \p InputIterator1's \c value_type is convertable to a type in \p OutputIterator1's set of \c value_types.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator2 and \p InputIterator1 have the same \c value_type,
+ *          and \p InputIterator2's \c value_type is convertable to a type in \p OutputIterator1's set of \c value_types.
+ *  \tparam InputIterator3 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \p InputIterator3's \c value_type is convertable to a type in \p OutputIterator2's set of \c value_types.
+ *  \tparam InputIterator4 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \p InputIterator4's \c value_type is convertable to a type in \p OutputIterator2's set of \c value_types.
+ *  \tparam OutputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>.
+ *  \tparam OutputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>.
+ *
+ *  \see \p set_difference
+ */
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_difference_by_key(InputIterator1 keys_first1,
+                          InputIterator1 keys_last1,
+                          InputIterator2 keys_first2,
+                          InputIterator2 keys_last2,
+                          InputIterator3 values_first1,
+                          InputIterator4 values_first2,
+                          OutputIterator1 keys_result,
+                          OutputIterator2 values_result);
+
+
+/*! This version of \p set_difference_by_key is identical to the first, except
+ *  that it compares keys using the function object \p comp.
+ *
+ *  \param keys_first1 The beginning of the first input range of keys.
+ *  \param keys_last1 The end of the first input range of keys.
+ *  \param keys_first2 The beginning of the second input range of keys.
+ *  \param keys_last2 The end of the second input range of keys.
+ *  \param values_first1 The beginning of the values corresponding to the first range of keys.
+ *  \param values_first2 The beginning of the values corresponding to the second range of keys.
+ *  \param keys_result The beginning of the output range of keys.
+ *  \param values_result The beginning of the output range of values.
+ *  \param comp Comparison operator.
+ *  \return A \p pair \c p such that <tt>p.first</tt> is the end of the output range of keys
+ *          and <tt>p.second</tt> is the end of the output range of values.
+ *
+ *  \see \p set_difference
+ */
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    set_difference_by_key(InputIterator1 keys_first1,
+                          InputIterator1 keys_last1,
+                          InputIterator2 keys_first2,
+                          InputIterator2 keys_last2,
+                          InputIterator3 values_first1,
+                          InputIterator4 values_first2,
+                          OutputIterator1 keys_result,
+                          OutputIterator2 values_result,
+                          StrictWeakOrdering comp);
+
+
+/*! \} // end set_operations
+ */
+
+} // end thrust
+
+#include <thrust/detail/set_difference.inl>
+
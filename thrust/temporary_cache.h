@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file temporary_cache.h
+ *  \brief Controls the cache of temporary storage used by algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <cstddef>
+
+namespace thrust
+{
+
+/*! \addtogroup memory_management Memory Management
+ *  \{
+ */
+
+/*! \p temporary_cache controls the cache from which algorithms such as
+ *  \p copy_if, \p reduce_by_key and \p unique obtain their temporary
+ *  storage on host-addressable device backends (OpenMP and threads).
+ *
+ *  Temporary allocations of up to 64 MB are rounded up to one of four size
+ *  classes per power of two and, once released, are kept for reuse by later
+ *  calls instead of being returned to the system.  The total number of cached
+ *  bytes never exceeds a high-water limit, which defaults to 256 MB or to the
+ *  number of megabytes in the environment variable
+ *  \c THRUST_TEMPORARY_CACHE_LIMIT_MB.  Larger allocations, and those made
+ *  while the limit is zero, take exactly the requested size and are never
+ *  cached.
+ *
+ *  The cache is thread-safe.  It requires C++11; otherwise, and with the
+ *  CUDA backend, these functions have no effect and temporaries are
+ *  allocated directly.
+ */
+namespace temporary_cache
+{
+
+/*! Releases every block currently held by the cache.
+ */
+inline void trim(void);
+
+/*! \return The high-water limit, in bytes.
+ */
+inline std::size_t limit(void);
+
+/*! Sets the high-water limit and releases cached blocks above it.
+ *  A limit of zero disables caching.
+ *
+ *  \param num_bytes The new limit, in bytes.
+ */
+inline void set_limit(std::size_t num_bytes);
+
+/*! \return The number of bytes currently held by the cache.
+ */
+inline std::size_t cached_bytes(void);
+
+} // end temporary_cache
+
+/*! \}
+ */
+
+} // end thrust
+
+#include <thrust/detail/temporary_cache.inl>
+
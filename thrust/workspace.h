@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file workspace.h
+ *  \brief Lets the caller provide the temporary storage used by algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/device_ptr.h>
+#include <thrust/functional.h>
+#include <thrust/detail/device/workspace.h>
+#include <cstddef>
+
+namespace thrust
+{
+
+/*! \addtogroup memory_management Memory Management
+ *  \{
+ */
+
+/*! \p scoped_workspace hands a preallocated region of device memory to the
+ *  algorithms called by the current thread.  While a \p scoped_workspace
+ *  exists, algorithms such as \p sort_by_key, \p reduce_by_key, \p copy_if,
+ *  \p unique_by_key and the segmented scans carve their temporary storage
+ *  from the region instead of allocating it, so that they perform no
+ *  allocations and their peak memory use is bounded by the size of the
+ *  region.  When the region is too small, the algorithm throws
+ *  \c std::bad_alloc.
+ *
+ *  The number of bytes a call requires is reported by the
+ *  <tt>*_workspace_bytes</tt> functions below.  Temporaries are placed at
+ *  multiples of 256 bytes from the beginning of the region, so they share
+ *  its alignment.
+ *
+ *  A \p scoped_workspace affects only the thread which constructed it, and
+ *  nested workspaces are used innermost first.  Workspaces require C++11 and
+ *  a host-addressable device backend (OpenMP or threads); otherwise they have
+ *  no effect and temporaries are allocated as usual.
+ *
+ *  The following code snippet demonstrates how to sort without allocating.
+ *
+ *  \code
+ *  #include <thrust/workspace.h>
+ *  #include <thrust/device_vector.h>
+ *  #include <thrust/sort.h>
+ *  ...
+ *  thrust::device_vector<int>   keys(n);
+ *  thrust::device_vector<float> values(n);
+ *
+ *  std::size_t num_bytes = thrust::sort_by_key_workspace_bytes<int,float>(n);
+ *  thrust::device_ptr<char> region = thrust::device_malloc<char>(num_bytes);
+ *
+ *  {
+ *    thrust::scoped_workspace workspace(region, num_bytes);
+ *
+ *    // the temporaries of sort_by_key live in region
+ *    thrust::sort_by_key(keys.begin(), keys.end(), values.begin());
+ *  }
+ *
+ *  thrust::device_free(region);
+ *  \endcode
+ */
+class scoped_workspace
+{
+  public:
+    /*! This constructor installs the region <tt>[ptr, ptr + num_bytes)</tt>
+     *  as the workspace of the calling thread.
+     *
+     *  \param ptr The beginning of the region.
+     *  \param num_bytes The size of the region, in bytes.
+     */
+    inline scoped_workspace(thrust::device_ptr<void> ptr, std::size_t num_bytes);
+
+    /*! The destructor reinstalls the workspace which was current when this
+     *  \p scoped_workspace was constructed.
+     */
+    inline ~scoped_workspace(void);
+
+    /*! \return The size of the region, in bytes.
+     */
+    inline std::size_t size(void) const;
+
+    /*! \return The number of bytes currently held by temporaries.
+     */
+    inline std::size_t bytes_in_use(void) const;
+
+    /*! \return The largest number of bytes held by temporaries at once.
+     */
+    inline std::size_t high_water_mark(void) const;
+
+  private:
+#if __THRUST_HAS_TEMPORARY_CACHE
+    thrust::detail::device::workspace m_workspace;
+#else
+    std::size_t m_size;
+#endif // __THRUST_HAS_TEMPORARY_CACHE
+
+    // disallow copy and assignment
+    scoped_workspace(const scoped_workspace &);
+    scoped_workspace &operator=(const scoped_workspace &);
+}; // end scoped_workspace
+
+
+/*! \return The number of bytes of workspace used by \p sort_by_key or
+ *          \p stable_sort_by_key of \p n keys of type \p KeyType and values of
+ *          type \p ValueType ordered by <tt>less<KeyType></tt>.
+ *
+ *  As with the other <tt>*_workspace_bytes</tt> functions, the result assumes
+ *  trivial iterators (e.g. \p device_vector iterators) and reflects the
+ *  execution configuration of the calling thread.
+ *
+ *  \param n The number of keys.
+ */
+template<typename KeyType,
+         typename ValueType>
+  std::size_t sort_by_key_workspace_bytes(std::size_t n);
+
+/*! \return The number of bytes of workspace used by \p sort_by_key or
+ *          \p stable_sort_by_key of \p n keys of type \p KeyType and values of
+ *          type \p ValueType ordered by \p comp.
+ *
+ *  \param n The number of keys.
+ *  \param comp The comparison operator.
+ */
+template<typename KeyType,
+         typename ValueType,
+         typename StrictWeakOrdering>
+  std::size_t sort_by_key_workspace_bytes(std::size_t n, StrictWeakOrdering comp);
+
+/*! \return The number of bytes of workspace used by \p reduce_by_key of
+ *          \p n keys whose output values are of type \p ValueType.
+ *
+ *  \param n The number of keys.
+ */
+template<typename ValueType>
+  std::size_t reduce_by_key_workspace_bytes(std::size_t n);
+
+/*! \return The number of bytes of workspace used by \p copy_if of \p n
+ *          elements.
+ *
+ *  \param n The number of elements.
+ */
+inline std::size_t copy_if_workspace_bytes(std::size_t n);
+
+/*! \return The number of bytes of workspace used by \p unique_by_key of
+ *          \p n keys of type \p KeyType and values of type \p ValueType.
+ *
+ *  \param n The number of keys.
+ */
+template<typename KeyType,
+         typename ValueType>
+  std::size_t unique_by_key_workspace_bytes(std::size_t n);
+
+namespace experimental
+{
+
+/*! \return The number of bytes of workspace used by
+ *          \p inclusive_segmented_scan of \p n elements whose output is of
+ *          type \p OutputType.
+ *
+ *  \param n The number of elements.
+ */
+template<typename OutputType>
+  std::size_t inclusive_segmented_scan_workspace_bytes(std::size_t n);
+
+/*! \return The number of bytes of workspace used by
+ *          \p exclusive_segmented_scan of \p n elements whose output is of
+ *          type \p OutputType.
+ *
+ *  \param n The number of elements.
+ */
+template<typename OutputType>
+  std::size_t exclusive_segmented_scan_workspace_bytes(std::size_t n);
+
+} // end experimental
+
+/*! \}
+ */
+
+} // end thrust
+
+#include <thrust/detail/workspace.inl>
+